@@ -7,8 +7,12 @@
 #include "imgui_test_engine/imgui_te_ui.h"
 
 #include <cstdio>
+#include <cstring>
 
 
+// In headless mode (--headless), ImmApp::RunTestsHeadless queues the tests
+static bool gHeadless = false;
+
 ImGuiTest *testOpenMetrics, *testCapture, *testExit;
 
 void MyRegisterTests()
@@ -44,6 +48,8 @@ void MyRegisterTests()
 
 void QueueAllTests()
 {
+    if (gHeadless)
+        return;
     static int idxFrameCount = 0;
     ++idxFrameCount;
     if (idxFrameCount == 3)
@@ -92,9 +98,13 @@ void WriteWin32SuccessFile()
 #endif
 
 
-int main(int, char *[])
+int main(int argc, char *argv[])
 {
     printf("Starting ci_automation_test_app\n");
+    for (int i = 1; i < argc; ++i)
+        if (strcmp(argv[i], "--headless") == 0)
+            gHeadless = true;
+
     try
     {
         HelloImGui::RunnerParams runnerParams;
@@ -102,6 +112,12 @@ int main(int, char *[])
 
         runnerParams.callbacks.ShowGui = AppGui;
         runnerParams.callbacks.RegisterTests = MyRegisterTests;
+        if (gHeadless)
+        {
+            // Run the tests of this shard (see run_sharded_tests.py) on the Null backends, with a virtual time step
+            int nbFailed = ImmApp::RunTestsHeadless(runnerParams, ImmApp::HeadlessTestsParamsFromEnvironment());
+            return nbFailed == 0 ? 0 : 1;
+        }
         ImmApp::Run(runnerParams);
     }
     catch(...)
@@ -0,0 +1,60 @@
+"""Runs a test app headless, with its registered tests sharded between several processes, then merges the results.
+
+The test app must call ImmApp::RunTestsHeadless(runnerParams, ImmApp::HeadlessTestsParamsFromEnvironment())
+(see ci_automation_test_app_bundle.cpp, when launched with --headless).
+
+Usage:
+    python run_sharded_tests.py [--shards N] [--results FILE] ./ci_automation_test_app_bundle --headless
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--shards", type=int, default=os.cpu_count() or 1, help="number of worker processes")
+    parser.add_argument("--results", default="test_results.txt", help="merged results file")
+    parser.add_argument("command", nargs=argparse.REMAINDER, help="test app command line")
+    args = parser.parse_args()
+    if not args.command:
+        parser.error("missing test app command line")
+
+    with tempfile.TemporaryDirectory() as results_dir:
+        processes = []
+        results_files = []
+        for shard_index in range(args.shards):
+            results_file = os.path.join(results_dir, f"shard_{shard_index}.txt")
+            env = dict(os.environ)
+            env["IMMAPP_TEST_SHARD_INDEX"] = str(shard_index)
+            env["IMMAPP_TEST_SHARD_COUNT"] = str(args.shards)
+            env["IMMAPP_TEST_RESULTS_FILE"] = results_file
+            processes.append(subprocess.Popen(args.command, env=env))
+            results_files.append(results_file)
+
+        nb_failed = 0
+        merged_lines = []
+        for shard_index, (process, results_file) in enumerate(zip(processes, results_files)):
+            return_code = process.wait()
+            if not os.path.isfile(results_file):
+                # The shard crashed before writing its results
+                print(f"shard {shard_index}: no results (exit code {return_code})")
+                merged_lines.append(f"error shard_{shard_index}/crashed\n")
+                nb_failed += 1
+                continue
+            with open(results_file) as f:
+                lines = f.readlines()
+            merged_lines += lines
+            nb_failed += sum(1 for line in lines if not line.startswith("success "))
+
+    with open(args.results, "w") as f:
+        f.writelines(sorted(merged_lines))
+    print(f"{len(merged_lines)} tests, {nb_failed} failed (results in {args.results})")
+    return 0 if nb_failed == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
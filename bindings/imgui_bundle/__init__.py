@@ -1,15 +1,17 @@
 # Part of ImGui Bundle - MIT License - Copyright (c) 2022-2023 Pascal Thomet - https://github.com/pthom/imgui_bundle
+import importlib
 import os
+from imgui_bundle import _imgui_bundle as _native_bundle  # type: ignore
 from imgui_bundle._imgui_bundle import __bundle_submodules__, __bundle_pyodide__ # type: ignore
 from imgui_bundle._imgui_bundle import __version__, compilation_time
-from typing import Union, Tuple, List
+from typing import Any, Callable, Dict, Union, Tuple, List
 
 
 def has_submodule(submodule_name):
     return submodule_name in __bundle_submodules__
 
 
-__all__ = ["__version__", "compilation_time"]
+__all__ = ["__version__", "compilation_time", "import_time_report"]
 
 
 #
@@ -62,9 +64,14 @@ if has_submodule("imgui"):
 if has_submodule("hello_imgui"):
     from imgui_bundle._imgui_bundle import hello_imgui as hello_imgui
     __all__.extend(["hello_imgui"])
-if has_submodule("implot"):
-    from imgui_bundle._imgui_bundle import implot as implot
-    __all__.extend(["implot"])
+
+
+#
+# Other submodules are initialized on first access (see __getattr__ below):
+# the initialization of the native submodules accounts for most of the import time.
+#
+def _load_implot():
+    from imgui_bundle._imgui_bundle import implot  # type: ignore
     # Flag types for ImPlot
     implot.LineFlags = int  # see implot.LineFlags_
     implot.ScatterFlags = int  # see implot.ScatterFlags_
@@ -73,69 +80,70 @@ if has_submodule("implot"):
     implot.BarsFlags = int  # see implot.BarsFlags_
     implot.PieChartFlags = int  # see implot.PieChartFlags_
     implot.HistogramFlags = int  # see implot.HistogramFlags_
-if has_submodule("implot3d"):
-    from imgui_bundle._imgui_bundle import implot3d as implot3d
-    __all__.extend(["implot3d"])
-if has_submodule("imgui_color_text_edit"):
-    from imgui_bundle._imgui_bundle import imgui_color_text_edit as imgui_color_text_edit
-    __all__.extend(["imgui_color_text_edit"])
-if has_submodule("imgui_node_editor"):
-    from imgui_bundle._imgui_bundle import imgui_node_editor as imgui_node_editor
-    from imgui_bundle import imgui_node_editor_ctx as imgui_node_editor_ctx  # noqa: E402
-    __all__.extend(["imgui_node_editor", "imgui_node_editor_ctx"])
-if has_submodule("imgui_knobs"):
-    from imgui_bundle._imgui_bundle import imgui_knobs as imgui_knobs
-    __all__.extend(["imgui_knobs"])
-if has_submodule("im_file_dialog"):
-    from imgui_bundle._imgui_bundle import im_file_dialog as im_file_dialog
-    __all__.extend(["im_file_dialog"])
-if has_submodule("imspinner"):
-    from imgui_bundle._imgui_bundle import imspinner as imspinner
-    __all__.extend(["imspinner"])
-if has_submodule("imgui_md"):
-    from imgui_bundle._imgui_bundle import imgui_md as imgui_md
-    __all__.extend(["imgui_md"])
-if has_submodule("immvision"):
-    from imgui_bundle._imgui_bundle import immvision as immvision
-    __all__.extend(["immvision"])
-if has_submodule("imguizmo"):
-    from imgui_bundle._imgui_bundle import imguizmo as imguizmo
-    __all__.extend(["imguizmo"])
-if has_submodule("imgui_tex_inspect"):
-    from imgui_bundle._imgui_bundle import imgui_tex_inspect as imgui_tex_inspect
-    __all__.extend(["imgui_tex_inspect"])
-if has_submodule("imgui_toggle"):
-    from imgui_bundle._imgui_bundle import imgui_toggle as imgui_toggle
-    __all__.extend(["imgui_toggle"])
-if has_submodule("portable_file_dialogs"):
-    from imgui_bundle._imgui_bundle import portable_file_dialogs as portable_file_dialogs
-    __all__.extend(["portable_file_dialogs"])
-if has_submodule("imgui_command_palette"):
-    from imgui_bundle._imgui_bundle import imgui_command_palette as imgui_command_palette
-    __all__.extend(["imgui_command_palette"])
-if has_submodule("imcoolbar"):
-    from imgui_bundle._imgui_bundle import im_cool_bar as im_cool_bar
-    __all__.extend(["im_cool_bar"])
-if has_submodule("nanovg"):
-    from imgui_bundle._imgui_bundle import nanovg as nanovg
-    __all__.extend(["nanovg"])
-
-if has_submodule("immapp_cpp"):  # immapp is a Python wrapper around immapp_cpp
-    from imgui_bundle import immapp as immapp
+    return implot
+
+
+def _native_submodule_loader(attr_name: str) -> Callable[[], Any]:
+    return lambda: getattr(_native_bundle, attr_name)
+
+
+def _python_module_loader(module_name: str) -> Callable[[], Any]:
+    return lambda: importlib.import_module(module_name)
+
+
+# attribute name -> (required native submodule, loader)
+_LAZY_ATTRIBUTES: Dict[str, Tuple[str, Callable[[], Any]]] = {
+    "implot": ("implot", _load_implot),
+    "implot3d": ("implot3d", _native_submodule_loader("implot3d")),
+    "imgui_color_text_edit": ("imgui_color_text_edit", _native_submodule_loader("imgui_color_text_edit")),
+    "imgui_node_editor": ("imgui_node_editor", _native_submodule_loader("imgui_node_editor")),
+    "imgui_node_editor_ctx": ("imgui_node_editor", _python_module_loader("imgui_bundle.imgui_node_editor_ctx")),
+    "imgui_knobs": ("imgui_knobs", _native_submodule_loader("imgui_knobs")),
+    "im_file_dialog": ("im_file_dialog", _native_submodule_loader("im_file_dialog")),
+    "imspinner": ("imspinner", _native_submodule_loader("imspinner")),
+    "imgui_md": ("imgui_md", _native_submodule_loader("imgui_md")),
+    "immvision": ("immvision", _native_submodule_loader("immvision")),
+    "imguizmo": ("imguizmo", _native_submodule_loader("imguizmo")),
+    "imgui_tex_inspect": ("imgui_tex_inspect", _native_submodule_loader("imgui_tex_inspect")),
+    "imgui_toggle": ("imgui_toggle", _native_submodule_loader("imgui_toggle")),
+    "portable_file_dialogs": ("portable_file_dialogs", _native_submodule_loader("portable_file_dialogs")),
+    "imgui_command_palette": ("imgui_command_palette", _native_submodule_loader("imgui_command_palette")),
+    "im_cool_bar": ("imcoolbar", _native_submodule_loader("im_cool_bar")),
+    "nanovg": ("nanovg", _native_submodule_loader("nanovg")),
+    # immapp is a Python wrapper around immapp_cpp
+    "immapp": ("immapp_cpp", _python_module_loader("imgui_bundle.immapp")),
     # Note: to enable font awesome 6:
     #     runner_params.callbacks.default_icon_font = hello_imgui.DefaultIconFont.font_awesome6
-    from imgui_bundle.immapp import icons_fontawesome_4 as icons_fontawesome_4
-    from imgui_bundle.immapp import icons_fontawesome_4 as icons_fontawesome  # v4  # noqa: F401
-    from imgui_bundle.immapp import icons_fontawesome_6 as icons_fontawesome_6
-    __all__.extend(["immapp", "icons_fontawesome_4", "icons_fontawesome", "icons_fontawesome_6"])
+    "icons_fontawesome_4": ("immapp_cpp", _python_module_loader("imgui_bundle.immapp.icons_fontawesome_4")),
+    "icons_fontawesome": ("immapp_cpp", _python_module_loader("imgui_bundle.immapp.icons_fontawesome_4")),  # v4
+    "icons_fontawesome_6": ("immapp_cpp", _python_module_loader("imgui_bundle.immapp.icons_fontawesome_6")),
+    # Python submodules
+    "imgui_fig": ("immvision", _python_module_loader("imgui_bundle.imgui_fig")),
+}
+__all__.extend(name for name, (submodule, _loader) in _LAZY_ATTRIBUTES.items() if has_submodule(submodule))
 
 
-#
-# Import Python submodules
-#
-if has_submodule("immvision"):
-    from imgui_bundle import imgui_fig as imgui_fig
-    __all__.extend(["imgui_fig"])
+def __getattr__(name: str) -> Any:
+    if name in _LAZY_ATTRIBUTES:
+        submodule, loader = _LAZY_ATTRIBUTES[name]
+        if has_submodule(submodule):
+            value = loader()
+            globals()[name] = value  # Next accesses will not go through __getattr__
+            return value
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+
+
+def __dir__() -> List[str]:
+    return sorted(set(globals()) | set(__all__))
+
+
+def import_time_report() -> str:
+    """Return the time spent initializing each native submodule which was used so far"""
+    durations = _native_bundle._submodules_init_durations()
+    lines = [f"    {name:<25} {seconds * 1000.:8.1f} ms" for name, seconds in durations]
+    total = sum(seconds for _name, seconds in durations)
+    lines.append(f"    {'total':<25} {total * 1000.:8.1f} ms")
+    return "imgui_bundle submodules initialization times:\n" + "\n".join(lines)
 
 
 # Glfw setup:
@@ -148,19 +156,11 @@ if has_submodule("with_glfw"):
     from imgui_bundle import glfw_utils as glfw_utils  # noqa: E402
 
 #
-# Pyodide: patch hello_imgui.run and immapp.run to work with Pyodide
-#
-if __bundle_pyodide__:
-    from imgui_bundle.pyodide_patch_runners import pyodide_do_patch_runners
-    pyodide_do_patch_runners()
-
-#
-# Jupyter notebook: patch hello_imgui.run and immapp.run to work with Jupyter notebook
+# Patch hello_imgui.run for Pyodide, Jupyter notebooks and tutorials screenshots
+# (immapp.run is patched the same way, when immapp is first imported)
 #
-from imgui_bundle.notebook_patch_runners import notebook_do_patch_runners_if_needed  # noqa: E402
-notebook_do_patch_runners_if_needed()
-from imgui_bundle._patch_runners_add_save_screenshot_param import patch_runners_add_save_screenshot_param  # noqa: E402
-patch_runners_add_save_screenshot_param()
+from imgui_bundle._patch_runners import patch_runner_module  # noqa: E402
+patch_runner_module(hello_imgui)
 
 #
 # Override assets folder
@@ -33,3 +33,8 @@ from .im_col32 import IM_COL32 as IM_COL32
 def compilation_time() -> str:
     """Return date and time when imgui_bundle was compiled"""
     pass
+
+def import_time_report() -> str:
+    """Return the time spent initializing each native submodule which was used so far
+    (submodules are initialized on first access)"""
+    pass
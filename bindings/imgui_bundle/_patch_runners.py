@@ -0,0 +1,19 @@
+"""Patch the run function of hello_imgui and immapp, depending on the environment:
+- Pyodide: render via javascript animation frames
+- Jupyter notebook: display a screenshot of the final app state
+- Tutorials: optionally save a screenshot of the final app state
+Each runner module is patched once, when it is first imported (immapp is imported lazily).
+"""
+from typing import Any
+
+
+def patch_runner_module(runner_module: Any) -> None:
+    from imgui_bundle._imgui_bundle import __bundle_pyodide__  # type: ignore
+    from imgui_bundle.notebook_patch_runners import notebook_do_patch_runners_if_needed
+    from imgui_bundle._patch_runners_add_save_screenshot_param import patch_runners_add_save_screenshot_param
+
+    if __bundle_pyodide__:
+        from imgui_bundle.pyodide_patch_runners import pyodide_do_patch_runners
+        pyodide_do_patch_runners(runner_module)
+    notebook_do_patch_runners_if_needed(runner_module)
+    patch_runners_add_save_screenshot_param(runner_module)
@@ -28,9 +28,8 @@ def _get_caller_filename(depth: int):
     return caller_file
 
 
-def patch_runners_add_save_screenshot_param() -> None:
-    from imgui_bundle import immapp, hello_imgui
-
+def patch_runners_add_save_screenshot_param(runner_module) -> None:
+    """Patch runner_module.run (runner_module is hello_imgui or immapp)"""
     def patch_runner(run_backup):
         def patched_run(*args, **kwargs):
             caller_file = _get_caller_filename(2)
@@ -48,8 +47,5 @@ def patch_runners_add_save_screenshot_param() -> None:
                 _save_hello_imgui_screenshot(image_file)
         return patched_run
 
-    immapp_run_backup = immapp.run
-    immapp.run = patch_runner(immapp_run_backup)
-
-    hello_imgui_run_backup = hello_imgui.run
-    hello_imgui.run = patch_runner(hello_imgui_run_backup)
+    run_backup = runner_module.run
+    runner_module.run = patch_runner(run_backup)
@@ -11548,6 +11548,23 @@ def get_drag_drop_payload_py_id() -> Optional[Payload_PyId]:
 ##################################################
 ImFontAtlas.get_tex_data_as_rgba32 = font_atlas_get_tex_data_as_rgba32  # type: ignore
 
+# numpy_view(): zero-copy numpy views of ImVector data, e.g. draw_list.vtx_buffer.numpy_view()
+# The returned arrays share the vector memory (they become invalid if the vector is modified).
+#   - ImVector_int, ImVector_uint, ImVector_float, ImVector_char, ImVector_uchar: 1D arrays
+#   - ImVector_ImVec2, ImVector_ImVec4: (N, 2) and (N, 4) float32 arrays
+#   - ImVector_ImDrawVert: structured array with fields pos (2 float32), uv (2 float32), col (uint32)
+def _imvector_numpy_view(self: Any) -> np.ndarray:
+    pass
+
+ImVector_int.numpy_view = _imvector_numpy_view  # type: ignore
+ImVector_uint.numpy_view = _imvector_numpy_view  # type: ignore
+ImVector_float.numpy_view = _imvector_numpy_view  # type: ignore
+ImVector_char.numpy_view = _imvector_numpy_view  # type: ignore
+ImVector_uchar.numpy_view = _imvector_numpy_view  # type: ignore
+ImVector_ImVec2.numpy_view = _imvector_numpy_view  # type: ignore
+ImVector_ImVec4.numpy_view = _imvector_numpy_view  # type: ignore
+ImVector_ImDrawVert.numpy_view = _imvector_numpy_view  # type: ignore
+
 # API for imgui_demo.cpp (specific to ImGui Bundle)
 def set_imgui_demo_window_pos(pos: ImVec2, size: ImVec2, cond: Cond) -> None:
     pass
@@ -31,6 +31,17 @@ def opengl3_create_device_objects() -> bool:
 def opengl3_destroy_device_objects() -> None:
     pass
 
+###############################################################################
+# Native draw loop for the pure python OpenGL backend
+###############################################################################
+def opengl_submit_draw_data(
+    draw_data: ImDrawData, vao_handle: int, vbo_handle: int, elements_handle: int, fb_height: int
+) -> None:
+    """Uploads and draws the command lists of draw_data (used by the pure python OpenGL backend).
+    The GL state (program, uniforms, blending, viewport, etc.) must be set up by the caller.
+    """
+    pass
+
 ###############################################################################
 # <bindings for imgui_impl_opengl2.h
 ###############################################################################
@@ -108,4 +108,46 @@ class ContextWrapper:
 
 ####################    </generated_from:imgui-command-palette-py-wrapper.h>    ####################
 
+
+####################    <generated_from:imcmd_fuzzy_index.h>    ####################
+
+
+class FuzzyMatch:
+    name: str
+    score: int = 0
+    # Byte offsets of the matched characters in Name (e.g. to highlight them)
+    matched_positions: List[int]
+    def __init__(self) -> None:
+        """Autogenerated default constructor"""
+        pass
+
+class FuzzyIndex:
+    """ FuzzyIndex: fuzzy search among many names (e.g. tens of thousands of commands), at each keystroke.
+     A name matches if the query is a subsequence of it (case insensitive). The scoring uses the same bonuses
+     as the command palette (consecutive letters, word starts, camel case, leading letters).
+
+     - Each name is stored lowercased in one contiguous buffer, together with a 64 bits mask of its characters:
+       most names are rejected by testing the mask.
+     - Search is incremental: when the query extends a previous query (or goes back to it, e.g. with backspace),
+       only the names which matched the previous query are tested.
+     - Only the best max_results matches are sorted.
+    """
+    def add_name(self, name: str) -> None:
+        pass
+    def remove_name(self, name: str) -> None:
+        pass
+    def clear(self) -> None:
+        pass
+    def size(self) -> int:
+        pass
+
+    def search(self, query: str, max_results: int = 50) -> List[FuzzyMatch]:
+        """Returns the best matches (at most max_results), best first. An empty query matches all the names."""
+        pass
+    def __init__(self) -> None:
+        """Autogenerated default constructor"""
+        pass
+
+####################    </generated_from:imcmd_fuzzy_index.h>    ####################
+
 # </litgen_stub> // Autogenerated code end!
@@ -376,9 +376,17 @@ class im_guizmo:  # Proxy class that introduces typings for the *submodule* im_g
 
     # Render a cube with face color corresponding to face normal. Usefull for debug/tests
     @staticmethod
+    @overload
     def draw_cubes(view: Matrix16, projection: Matrix16, matrices: List[Matrix16]) -> None:
         pass
     @staticmethod
+    @overload
+    def draw_cubes(view: Matrix16, projection: Matrix16, matrices: np.ndarray, frustum_culling: bool = True) -> None:
+        """ Render the cubes whose matrices are stored in a C-contiguous float32 array of shape (N, 4, 4), without copying it.
+         If frustum_culling is True, cubes outside the view frustum are skipped.
+        """
+        pass
+    @staticmethod
     def draw_grid(
         view: Matrix16,
         projection: Matrix16,
@@ -388,6 +396,7 @@ class im_guizmo:  # Proxy class that introduces typings for the *submodule* im_g
         pass
 
     @staticmethod
+    @overload
     def manipulate(
         view: Matrix16,
         projection: Matrix16,
@@ -401,6 +410,23 @@ class im_guizmo:  # Proxy class that introduces typings for the *submodule* im_g
         ) -> bool:
         """ Manipulate may change the objectMatrix parameter (return True if modified)"""
         pass
+    @staticmethod
+    @overload
+    def manipulate(
+        view: Matrix16,
+        projection: Matrix16,
+        operation: OPERATION,
+        mode: MODE,
+        object_matrix: np.ndarray,
+        delta_matrix: Optional[Matrix16] = None,
+        snap: Optional[Matrix3] = None,
+        local_bounds: Optional[Matrix6] = None,
+        bounds_snap: Optional[Matrix3] = None
+        ) -> bool:
+        """ Manipulate a float32 array of shape (4, 4) in place (e.g. matrices[i], where matrices has the shape (N, 4, 4)).
+         Return True if modified
+        """
+        pass
 
     @staticmethod
     @overload
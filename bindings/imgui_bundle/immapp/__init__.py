@@ -1,8 +1,13 @@
 # Part of ImGui Bundle - MIT License - Copyright (c) 2022-2023 Pascal Thomet - https://github.com/pthom/imgui_bundle
+import sys
 from imgui_bundle import _imgui_bundle as _native_bundle
 from imgui_bundle._imgui_bundle import immapp_cpp as immapp_cpp  # type: ignore
 from imgui_bundle._imgui_bundle.immapp_cpp import (  # type: ignore
     clock_seconds,
+    set_clock_uses_imgui_time,
+    get_frame_clock,
+    FrameClock,
+    FixedTimestepAccumulator,
 
     default_node_editor_context,
     default_node_editor_config,
@@ -19,6 +24,40 @@ from imgui_bundle._imgui_bundle.immapp_cpp import (  # type: ignore
     run,
     run_with_markdown,
     AddOnsParams,
+    StartupTimings,
+    get_startup_timings,
+    LogParams,
+    set_log_params,
+    log,
+    log_clear,
+    log_gui,
+    software_render_draw_data,
+    request_redraw,
+    animate_until,
+    animate_for,
+    end_animation,
+    required_animation_fps,
+    UnchangedFramesStats,
+    get_unchanged_frames_stats,
+    hash_draw_data,
+    push_cached_tweaked_theme,
+    pop_cached_tweaked_theme,
+    clear_theme_cache,
+    SettingsJournal,
+    get_settings_journal,
+    settings_journal_location,
+    final_app_window_software_screenshot,
+    AsyncReadback,
+    request_app_window_screenshot,
+    poll_app_window_screenshot,
+    DrawDataStreamParams,
+    DrawDataStreamEncoder,
+    DrawDataStreamDecoder,
+    DecodedDrawList,
+    DecodedDrawCmd,
+    RemotingLinkParams,
+    RemotingLoopbackStats,
+    RemotingLoopback,
     snippets,
 
     begin_plot_in_node_editor,
@@ -54,6 +93,10 @@ manual_render = _native_bundle.immapp_cpp.manual_render
 
 __all__ = [
     "clock_seconds",
+    "set_clock_uses_imgui_time",
+    "get_frame_clock",
+    "FrameClock",
+    "FixedTimestepAccumulator",
     "default_node_editor_context",
     "default_node_editor_config",
     "delete_node_editor_settings",
@@ -66,6 +109,40 @@ __all__ = [
     "run",
     "run_with_markdown",
     "AddOnsParams",
+    "StartupTimings",
+    "get_startup_timings",
+    "LogParams",
+    "set_log_params",
+    "log",
+    "log_clear",
+    "log_gui",
+    "software_render_draw_data",
+    "request_redraw",
+    "animate_until",
+    "animate_for",
+    "end_animation",
+    "required_animation_fps",
+    "UnchangedFramesStats",
+    "get_unchanged_frames_stats",
+    "hash_draw_data",
+    "push_cached_tweaked_theme",
+    "pop_cached_tweaked_theme",
+    "clear_theme_cache",
+    "SettingsJournal",
+    "get_settings_journal",
+    "settings_journal_location",
+    "final_app_window_software_screenshot",
+    "AsyncReadback",
+    "request_app_window_screenshot",
+    "poll_app_window_screenshot",
+    "DrawDataStreamParams",
+    "DrawDataStreamEncoder",
+    "DrawDataStreamDecoder",
+    "DecodedDrawList",
+    "DecodedDrawCmd",
+    "RemotingLinkParams",
+    "RemotingLoopbackStats",
+    "RemotingLoopback",
     "icons_fontawesome",  # v4
     "icons_fontawesome_4",
     "icons_fontawesome_6",
@@ -84,3 +161,8 @@ __all__ = [
     "widget_with_resize_handle_in_node_editor_em",
     "immapp_code_utils",
 ]
+
+
+# Patch immapp.run for Pyodide, Jupyter notebooks and tutorials screenshots (as was done for hello_imgui.run)
+from imgui_bundle._patch_runners import patch_runner_module  # noqa: E402
+patch_runner_module(sys.modules[__name__])
@@ -3,7 +3,8 @@
 # ruff: noqa: B008, F821
 from typing import Tuple, Optional, Callable, List, overload, Any
 import enum
-from imgui_bundle import imgui_md, hello_imgui, ImVec2, ImVec2Like
+import numpy as np
+from imgui_bundle import imgui, imgui_md, hello_imgui, ImVec2, ImVec2Like, ImVec4, ImVec4Like
 from imgui_bundle.imgui_node_editor import (
     Config as NodeEditorConfig,
     EditorContext as NodeEditorContext,
@@ -12,6 +13,8 @@ from imgui_bundle.imgui_node_editor import (
 ImPlotFlags = int  # see implot.Flags_
 ImGuiMd = imgui_md
 HelloImGui = hello_imgui
+ImGuiTheme = hello_imgui
+ImGuiID = int
 
 VoidFunction = Callable[[], Any]
 ScreenSize = Tuple[int, int]
@@ -26,11 +29,42 @@ DefaultScreenSize = (800, 600)
 
 # #ifdef IMGUI_BUNDLE_WITH_IMPLOT_AND_IMGUI_NODE_EDITOR
 #
+class PlotInNodeEditorParams:
+    """PlotInNodeEditorParams: tune how plots inside a node editor are culled
+    (applies to BeginPlotInNodeEditor and ShowResizablePlotInNodeEditor)
+    """
+
+    # If True, plots that are outside the visible region of the node editor are not plotted:
+    # only their size is reserved
+    cull_offscreen_plots: bool = True
+    # When the node editor is zoomed out so that the plot is displayed at less than this scale
+    # (on screen pixels per canvas pixel), a cached snapshot of the plot is displayed instead
+    # of plotting it live. Set to 0 to always plot live.
+    # The snapshot is a low resolution image (rasterized at this scale), taken once,
+    # when the zoom goes below twice this scale.
+    snapshot_zoom_threshold: float = 0.5
+    # Maximum number of cached snapshots (the least recently displayed plots are discarded first)
+    max_snapshots: int = 512
+    def __init__(
+        self, cull_offscreen_plots: bool = True, snapshot_zoom_threshold: float = 0.5, max_snapshots: int = 512
+    ) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def get_plot_in_node_editor_params() -> PlotInNodeEditorParams:
+    pass
+
 def begin_plot_in_node_editor(
     title_id: str, size: Optional[ImVec2Like] = None, flags: ImPlotFlags = 0
 ) -> bool:
-    """Python bindings defaults:
-    If size is None, then its default value will be: ImVec2(-1,0)
+    """These functions wrap ImPlot::BeginPlot and ImPlot::EndPlot,
+    but they enable to make the plot content draggable inside a node.
+    BeginPlotInNodeEditor returns False (and only reserves the plot size) if the plot is culled
+    (see PlotInNodeEditorParams): in this case, do not call EndPlotInNodeEditor.
+
+
+    Python bindings defaults:
+        If size is None, then its default value will be: ImVec2(-1,0)
     """
     pass
 
@@ -127,7 +161,8 @@ class AddOnsParams:
 
     # If True, the node editor colors will be updated from the ImGui colors
     # (i.e. if using a light theme, the node editor will use a light theme, etc.)
-    # This is called after runnerParams.callbacks.SetupImGuiStyle, in which you can set the ImGui style.
+    # This is called after runnerParams.callbacks.SetupImGuiStyle, in which you can set the ImGui style,
+    # and then again whenever the ImGui style colors change.
     # If you set this to False, you can set the node editor style manually.
     # (Note: you can also the theme via RunnerParams.imguiParams.tweakedTheme)
     update_node_editor_colors_from_imgui_colors: bool = True
@@ -136,6 +171,31 @@ class AddOnsParams:
 
     # You can tweak MarkdownOptions (but this is optional)
     with_markdown_options: Optional[ImGuiMd.MarkdownOptions] = None
+
+    # Assets (fonts, images, ...) that will be loaded on worker threads while the window is being created.
+    # Use ImmApp::LoadAssetShared() to access them once loaded (HelloImGui's own loaders, such as LoadFont
+    # or ImageAndSizeFromAsset, read the files again).
+    prefetch_assets: List[str] = List[str]()
+
+    # Set buildFontAtlasInParallel=True to rasterize the fonts on several threads at startup
+    # (useful when many fonts are loaded, e.g. with markdown, on slow devices).
+    # See GetStartupTimings() to measure its effect.
+    build_font_atlas_in_parallel: bool = False
+
+    # Set withAdaptiveIdling=True to let ImmApp set runnerParams.fpsIdling.fpsIdle at each frame:
+    # it will be the lowest fps which satisfies all the animation leases (see AnimateUntil in frame_pacing.h),
+    # or fpsIdleWithoutLease when there are none. Use RequestRedraw() to display new data immediately.
+    with_adaptive_idling: bool = False
+    fps_idle_without_lease: float = 1.0
+
+    # Set throttleUnchangedFrames=True to avoid rendering frames at full speed when their output does not change
+    # (see GetUnchangedFramesStats in frame_pacing.h)
+    throttle_unchanged_frames: bool = False
+
+    # Set withJournaledSettings=True to store the settings incrementally in a journal (see settings_journal.h):
+    # the node editor settings are appended to it when they change (instead of rewriting .node_editor.json),
+    # and the ImGui settings are restored after a crash.
+    with_journaled_settings: bool = False
     def __init__(
         self,
         with_implot: bool = False,
@@ -146,6 +206,12 @@ class AddOnsParams:
         with_node_editor_config: Optional[NodeEditorConfig] = None,
         update_node_editor_colors_from_imgui_colors: bool = True,
         with_markdown_options: Optional[ImGuiMd.MarkdownOptions] = None,
+        prefetch_assets: Optional[List[str]] = None,
+        build_font_atlas_in_parallel: bool = False,
+        with_adaptive_idling: bool = False,
+        fps_idle_without_lease: float = 1.0,
+        throttle_unchanged_frames: bool = False,
+        with_journaled_settings: bool = False,
     ) -> None:
         """Auto-generated default constructor with named params"""
         pass
@@ -242,6 +308,26 @@ def run_with_markdown(
     """
     pass
 
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Startup timings
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+class StartupTimings:
+    # Time between the application setup (ImmApp::Run or ManualRender::SetupFromXXX)
+    # and the end of the first frame, in seconds
+    time_to_first_frame: float = 0.0
+    # Duration of the font atlas build, in seconds (only measured when AddOnsParams.buildFontAtlasInParallel
+    # is True: otherwise, the atlas is built by the renderer during the first frame)
+    font_atlas_build_duration: float = 0.0
+    def __init__(self, time_to_first_frame: float = 0.0, font_atlas_build_duration: float = 0.0) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def get_startup_timings() -> StartupTimings:
+    """Returns the timings measured during the last application startup"""
+    pass
+
 # ///////////////////////////////////////////////////////////////////////////////////////
 #
 # Dpi aware utilities (which call the same utilities from HelloImGui)
@@ -396,9 +482,69 @@ class manual_render:  # Proxy class that introduces typings for the *submodule*
 ####################    <generated_from:clock.h>    ####################
 
 def clock_seconds() -> float:
-    """Chronometer in seconds"""
+    """Chronometer in seconds (monotonic)"""
+    pass
+
+def set_clock_uses_imgui_time(use_imgui_time: bool) -> None:
+    """If set to True, ClockSeconds() returns ImGui::GetTime(), i.e. a time that only advances by io.DeltaTime
+    at each frame. Used by headless test runs with a fixed virtual time step (see RunTestsHeadless),
+    so that animations do not depend on the machine speed.
+    Must be called from the thread which runs ImGui: the other threads get the last ImGui time it read
+    (the frame clock reads it before each frame).
+    """
+    pass
+
+class FrameClock:
+    """FrameClock: the clock is sampled once per frame, so that all the widgets and animations
+    of a frame share the same time stamp (instead of each sampling the OS clock).
+    """
+
+    # Time of the current frame, in seconds (same origin as ClockSeconds())
+    frame_time: float = 0.0
+    # Time elapsed between the previous frame and the current frame, in seconds
+    delta_time: float = 0.0
+    # Index of the current frame (0 for the first frame)
+    frame_index: int = 0
+    def __init__(self, frame_time: float = 0.0, delta_time: float = 0.0, frame_index: int = 0) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def get_frame_clock() -> FrameClock:
+    """Returns the clock of the current frame.
+    ImmApp::Run samples it before each frame. Outside of ImmApp::Run, it is sampled on the first call
+    of each ImGui frame (or on each call if there is no ImGui context): frameIndex then follows
+    ImGui::GetFrameCount(), and deltaTime is the time elapsed since the previous call.
+    """
     pass
 
+class FixedTimestepAccumulator:
+    """FixedTimestepAccumulator: helps to advance an animation or a simulation by fixed steps,
+    independently of the frame rate. Usage:
+        static ImmApp::FixedTimestepAccumulator accumulator(1. / 60.);
+        int nbSteps = accumulator.Advance();
+        for (int i = 0; i < nbSteps; ++i)
+            MySimulationStep(accumulator.step);
+    """
+
+    # Duration of a step, in seconds
+    step: float = 1.0 / 60.0
+    # Maximum number of steps returned by Advance (avoids a spiral of death after a long hitch)
+    max_steps_per_advance: int = 8
+    # Time accumulated, which was not yet consumed by steps
+    accumulated_time: float = 0.0
+
+    def __init__(self, step_: float = 1.0 / 60.0) -> None:
+        pass
+
+    def advance(self, delta_time: float = -1.0) -> int:
+        """Accumulates deltaTime (or the frame clock deltaTime, if deltaTime < 0),
+        and returns the number of steps to perform
+        """
+        pass
+    def alpha(self) -> float:
+        """Position between the last step and the next one, in [0, 1[ (useful to interpolate the display)"""
+        pass
+
 ####################    </generated_from:clock.h>    ####################
 
 ####################    <generated_from:code_utils.h>    ####################
@@ -536,4 +682,330 @@ class snippets:  # Proxy class that introduces typings for the *submodule* snipp
 # </submodule snippets>
 ####################    </generated_from:snippets.h>    ####################
 
+####################    <generated_from:logger.h>    ####################
+
+class LogParams:
+    """ImmApp::Log is an alternative to HelloImGui::Log, for applications which log a lot, from several threads:
+    - Log() can be called from any thread. It is wait-free and does not allocate: messages are formatted
+      into a preallocated ring buffer (and truncated to LogParams::maxMessageLength).
+    - Only the last LogParams::capacity messages are retained: older messages are overwritten.
+    - LogGui() only renders the visible lines, with level filters and a search field:
+      its cost per frame does not depend on the number of retained messages.
+      LogGui() must be called from the main thread.
+    """
+
+    # Number of retained messages (rounded up to a power of two)
+    capacity: int = 65536
+    # Maximum length of a message, in bytes (longer messages are truncated)
+    max_message_length: int = 256
+    def __init__(self, capacity: int = 65536, max_message_length: int = 256) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def set_log_params(params: LogParams) -> None:
+    """SetLogParams must be called before the first call to Log (the ring buffer is allocated on first use)"""
+    pass
+
+def log(level: HelloImGui.LogLevel, format: str) -> None:
+    pass
+
+def log_clear() -> None:
+    pass
+
+def log_gui(size: Optional[ImVec2Like] = None) -> None:
+    """Python bindings defaults:
+    If size is None, then its default value will be: ImVec2(0., 0.)
+    """
+    pass
+
+####################    </generated_from:logger.h>    ####################
+
+####################    <generated_from:frame_pacing.h>    ####################
+# Frame pacing: lets data dashboards idle at ~0% CPU, while still displaying new data within one frame.
+#
+# - RequestRedraw() can be called from any thread (e.g. by a background data producer):
+#   if the main loop is idling, it is woken up, and one new frame is rendered.
+#   (with the Glfw and Sdl platform backends. With FpsIdlingMode::EarlyReturn, e.g. under emscripten,
+#   the new frame is rendered at the next idle frame)
+# - AnimateUntil() takes an animation "lease": until its end, the app is rendered at least at the given fps.
+#   Leases are identified by an ImGuiID, so that a widget can renew its own lease at each frame.
+# - When AddOnsParams::withAdaptiveIdling is True, runnerParams.fpsIdling.fpsIdle is updated at each frame:
+#   it is the lowest fps which satisfies all the active leases (or AddOnsParams::fpsIdleWithoutLease
+#   when there are none).
+
+def request_redraw() -> None:
+    """Wakes up the main loop, so that a new frame is rendered (thread-safe)"""
+    pass
+
+def animate_until(lease_id: ImGuiID, until_time: float, fps: float = 0.0) -> None:
+    """Requests frames at least at `fps` (0: maximum refresh speed) until ClockSeconds() reaches untilTime.
+    Calling it again with the same leaseId replaces the lease (thread-safe)
+    """
+    pass
+
+def animate_for(lease_id: ImGuiID, duration: float, fps: float = 0.0) -> None:
+    """Same as AnimateUntil(leaseId, ClockSeconds() + duration, fps)"""
+    pass
+
+def end_animation(lease_id: ImGuiID) -> None:
+    """Ends a lease before its end time"""
+    pass
+
+def required_animation_fps() -> float:
+    """The fps required by the active leases (-1 if there are none, 0 for the maximum refresh speed)"""
+    pass
+
+class UnchangedFramesStats:
+    """Unchanged frames: many frames produce the same draw data as the previous frame (cursor parked,
+    nothing animating). When AddOnsParams::throttleUnchangedFrames is True, ImmApp hashes the draw data
+    of each frame, and counts those frames: after an unchanged frame, the main loop waits for an event
+    (user input, RequestRedraw(), ...) during at most 1 / fpsIdle seconds (or 1 / RequiredAnimationFps()),
+    instead of rendering the next frame immediately. Otherwise, the stats stay at zero.
+    """
+
+    # Number of rendered frames
+    nb_frames: int = 0
+    # Number of frames whose draw data was identical to the previous frame's
+    nb_unchanged_frames: int = 0
+    # Number of unchanged frames after which the main loop waited for an event
+    nb_throttled_frames: int = 0
+    def __init__(self, nb_frames: int = 0, nb_unchanged_frames: int = 0, nb_throttled_frames: int = 0) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def get_unchanged_frames_stats() -> UnchangedFramesStats:
+    pass
+
+def hash_draw_data(draw_data: imgui.ImDrawData) -> int:
+    """Hash of the draw data (vertices, indices, commands and display rect)"""
+    pass
+
+####################    </generated_from:frame_pacing.h>    ####################
+
+####################    <generated_from:theme_cache.h>    ####################
+# Theme cache: ImGuiTheme::PushTweakedTheme() computes a full ImGuiStyle from the theme and its tweaks
+# (with HSV conversions of all the colors) at each call. When themes are pushed for sub-panels at every frame,
+# use PushCachedTweakedTheme() / PopCachedTweakedTheme() instead: the style of a (theme, tweaks) pair
+# is computed once, and pushing or popping it only copies a style.
+#
+# Call ClearThemeCache() if ImGuiTheme::TweakedThemeThemeToStyle() would give different results
+# (e.g. after a DPI change). The cache is cleared when the app exits.
+
+def push_cached_tweaked_theme(tweaked_theme: ImGuiTheme.ImGuiTweakedTheme) -> None:
+    """Same as ImGuiTheme::PushTweakedTheme() / PopTweakedTheme(), with cached styles"""
+    pass
+
+def pop_cached_tweaked_theme() -> None:
+    pass
+
+def clear_theme_cache() -> None:
+    pass
+
+####################    </generated_from:theme_cache.h>    ####################
+
+####################    <generated_from:settings_journal.h>    ####################
+
+class SettingsJournal:
+    """SettingsJournal: a persistent key/value store for settings, which is written incrementally.
+    - Set() appends the changed key to the journal file (unchanged values are not written),
+      so that the settings survive a crash, and nothing remains to be written at exit.
+    - The file is read lazily, on the first access.
+    - When the journal grows much larger than the live settings, it is compacted on a background thread.
+      Compaction never delays the exit: it is cancelled if the journal is closed in the meantime.
+    All the methods are thread-safe.
+
+    Each record is flushed to the OS when written: the settings survive an app crash
+    (but not necessarily a power loss). A record torn by a crash is ignored when loading.
+    """
+
+    def __init__(self, filename: str) -> None:
+        pass
+
+    def get(self, key: str) -> Optional[str]:
+        pass
+    def has(self, key: str) -> bool:
+        pass
+    def set(self, key: str, value: str) -> None:
+        pass
+    def erase(self, key: str) -> None:
+        pass
+
+    def compact(self) -> None:
+        """Rewrites the journal with only the live settings (synchronously)"""
+        pass
+
+    def filename(self) -> str:
+        pass
+
+# Journaled settings of the app: when AddOnsParams::withJournaledSettings is True, ImmApp opens a SettingsJournal
+# next to the ini file (see SettingsJournalLocation), and stores in it:
+# - the node editor settings (instead of rewriting the whole .node_editor.json file at each change):
+#   one key per node, and one for the view state. An existing .node_editor.json file is imported once.
+#   Note: the node editor still serializes all the nodes when it saves its settings (e.g. when destroyed);
+#   they are only parsed if the view state changed.
+# - the ImGui ini settings, whenever ImGui marks them as modified: if the app crashes, they are
+#   restored at the next start (after a normal exit, HelloImGui saves them in the ini file as usual).
+# - the user preferences saved with SaveUserPrefToJournal().
+# Apps may store their own settings in it, via GetSettingsJournal().
+
+def get_settings_journal() -> SettingsJournal:
+    """Returns the settings journal of the running app (None if AddOnsParams::withJournaledSettings is False)"""
+    pass
+
+def settings_journal_location(runner_params: HelloImGui.RunnerParams) -> str:
+    """SettingsJournalLocation returns the path to the settings journal:
+    path/to/your/app.ini => path/to/your/app.settings_journal
+    """
+    pass
+
+def save_user_pref_to_journal(user_pref_name: str, user_pref_content: str) -> None:
+    """SaveUserPrefToJournal / LoadUserPrefFromJournal: same as HelloImGui::SaveUserPref / LoadUserPref,
+    but the preference is written to the settings journal as soon as it is saved (not only at exit).
+    If the journal is disabled, they call HelloImGui::SaveUserPref / LoadUserPref.
+    LoadUserPrefFromJournal falls back to the preferences saved by HelloImGui::SaveUserPref.
+    """
+    pass
+
+def load_user_pref_from_journal(user_pref_name: str) -> str:
+    pass
+
+####################    </generated_from:settings_journal.h>    ####################
+
 # </litgen_stub> // Autogenerated code end!
+
+# Software renderer (manual bindings)
+def software_render_draw_data(
+    draw_data: imgui.ImDrawData, nb_threads: int = 0, clear_color: ImVec4Like = ImVec4(0.0, 0.0, 0.0, 1.0)
+) -> np.ndarray:
+    """Renders draw_data on the CPU, and returns an RGBA image (numpy array of shape (height, width, 4))"""
+    pass
+
+def final_app_window_software_screenshot() -> np.ndarray:
+    """When the renderer backend is Null, returns the last frame of the last (exited) app, rendered on the CPU (RGBA)"""
+    pass
+
+# Asynchronous readback (manual bindings)
+class AsyncReadback:
+    """Asynchronous readback of textures (OpenGL renderer only): the pixels are received one or two frames
+    after the request, without stalling the GPU. Read only the region you need.
+    """
+
+    def __init__(self, nb_buffers: int = 3) -> None:
+        pass
+    def request_texture_region(self, texture: imgui.ImTextureID, x: int, y: int, width: int, height: int) -> bool:
+        """Queues a copy of a region of an RGBA texture.
+        Returns False if all the buffers are in flight (call poll() at each frame to receive them)
+        """
+        pass
+    def poll(self) -> bool:
+        """Receives the requests which the GPU has finished, without waiting.
+        Returns True if latest_image() was updated
+        """
+        pass
+    def latest_image(self) -> np.ndarray:
+        """The last received region (RGBA numpy array of shape (height, width, 4))"""
+        pass
+    def nb_pending_requests(self) -> int:
+        pass
+    def release(self) -> None:
+        """Deletes the OpenGL objects (call it before the OpenGL context is destroyed)"""
+        pass
+
+def request_app_window_screenshot() -> None:
+    """Requests an asynchronous screenshot of the app window (OpenGL renderer only): see poll_app_window_screenshot()"""
+    pass
+
+def poll_app_window_screenshot() -> Optional[np.ndarray]:
+    """Returns the requested screenshot once it was received (RGBA numpy array of shape (height, width, 4)), or None"""
+    pass
+
+# Draw data streaming (manual bindings)
+class DrawDataStreamParams:
+    position_subdivisions: int = 16  # Positions and clip rects are rounded to 1 / position_subdivisions pixels
+    min_frame_interval: float = 1.0 / 60.0  # The frame rate will not exceed 1 / min_frame_interval
+    initial_bandwidth: float = 1e6  # Initial bandwidth estimation (bytes per second), before the first packet is delivered
+    def __init__(self) -> None:
+        pass
+
+class DrawDataStreamEncoder:
+    """Encodes ImDrawData into compact packets, for remoting over slow links (see DrawDataStreamDecoder)"""
+
+    def __init__(self, params: DrawDataStreamParams = DrawDataStreamParams()) -> None:
+        pass
+    def encode_frame(self, draw_data: imgui.ImDrawData, now: float = -1.0) -> bytes:
+        """Encodes a frame into a packet (now: send time, default clock_seconds())"""
+        pass
+    def request_key_frame(self) -> None:
+        """The next packet will not refer to the previous frame (e.g. when a new client connects)"""
+        pass
+    def shall_send_frame(self, now: float) -> bool:
+        """Adaptive frame rate: returns True if a frame shall be sent now"""
+        pass
+    def on_packet_delivered(self, packet_size: int, transfer_duration: float) -> None:
+        """Shall be called by the transport when a packet was delivered (transfer_duration does not include the latency)"""
+        pass
+    def estimated_bandwidth(self) -> float:
+        pass
+
+class DecodedDrawCmd:
+    clip_rect: ImVec4
+    texture_id: int
+    vtx_offset: int
+    idx_offset: int
+    elem_count: int
+
+class DecodedDrawList:
+    vtx_buffer: List[imgui.ImDrawVert]
+    idx_buffer: List[int]
+    cmd_buffer: List[DecodedDrawCmd]
+
+class DrawDataStreamDecoder:
+    """The client side: decodes the packets of a DrawDataStreamEncoder"""
+
+    display_pos: ImVec2
+    display_size: ImVec2
+    framebuffer_scale: ImVec2
+    draw_lists: List[DecodedDrawList]
+    frame_index: int
+    def __init__(self) -> None:
+        pass
+    def decode_frame(self, packet: bytes) -> bool:
+        """Returns False if the packet is invalid (including commands which refer to vertices or indices
+        out of their list), or refers to a list which could not be decoded
+        """
+        pass
+
+class RemotingLinkParams:
+    bandwidth: float = 1e6  # Bytes per second
+    latency: float = 0.03  # One way latency, in seconds
+    def __init__(self) -> None:
+        pass
+
+class RemotingLoopbackStats:
+    nb_frames_rendered: int
+    nb_frames_sent: int
+    nb_frames_decoded: int
+    bytes_sent: float
+    raw_bytes: float
+    average_latency: float
+    last_latency: float
+    encode_duration: float
+    decode_duration: float
+
+class RemotingLoopback:
+    """A local stand-in for a remote client: the frames are encoded, sent through a simulated link,
+    and decoded, so that the throughput and the latency can be measured on one machine.
+    Usage: runner_params.callbacks.after_swap = lambda: loopback.on_frame_rendered(imgui.get_draw_data())
+    """
+
+    def __init__(
+        self, link_params: RemotingLinkParams = RemotingLinkParams(), stream_params: DrawDataStreamParams = DrawDataStreamParams()
+    ) -> None:
+        pass
+    def on_frame_rendered(self, draw_data: imgui.ImDrawData, now: float = -1.0) -> None:
+        """Call this after each frame (e.g. in runner_params.callbacks.after_swap)"""
+        pass
+    def stats(self) -> RemotingLoopbackStats:
+        pass
+    def client(self) -> DrawDataStreamDecoder:
+        pass
@@ -86,6 +86,9 @@ def _run_app_function_and_display_image_in_notebook(
 
         app_function()
         app_image = hello_imgui.final_app_window_screenshot()
+        if app_image.size == 0:
+            # No GPU screenshot (e.g. Null renderer backend): use the frame rendered on the CPU
+            app_image = immapp.final_app_window_software_screenshot()[:, :, :3]
 
         scale = hello_imgui.final_app_window_screenshot_framebuffer_scale()
         if thumbnail_ratio == 0.0:
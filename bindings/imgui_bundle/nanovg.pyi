@@ -1221,6 +1221,12 @@ class nvg_imgui:  # Proxy class that introduces typings for the *submodule* nvg_
         """ NvgFramebuffer: a framebuffer that can be used by NanoVG + ImGui
          Internally stored inside the renderer backend (e.g. OpenGL)
          Note: this class can be instantiated only after a valid renderer backend (OpenGL) has been created
+
+         Width and Height are expressed in drawing units: this is the size that NanoVG drawing functions see.
+         The texture is allocated at Width * PixelRatio x Height * PixelRatio pixels, where PixelRatio defaults
+         to ImGui::GetIO().DisplayFramebufferScale (so that the drawing is crisp on HiDPI screens).
+         If Supersampling > 1, the drawing is rendered at Supersampling times this resolution, and then resolved
+         (i.e. downscaled) into the texture.
         """
         # NVGcontext *vg = nullptr;    /* original C++ signature */
         vg: Context = None
@@ -1233,15 +1239,38 @@ class nvg_imgui:  # Proxy class that introduces typings for the *submodule* nvg_
         # ImTextureID TextureId = {};    /* original C++ signature */
         texture_id: ImTextureID = ImTextureID()
 
-        # Warning: this constructor can be called only after a valid renderer backend (OpenGL) has been created
-        # (will call Init())
+        # float PixelRatio = 1.f;    /* original C++ signature */
+        pixel_ratio: float = 1.0  # Ratio between texture pixels and drawing units (read-only: use SetPixelRatio or UpdateResolutionTier)
+        # int Supersampling = 1;    /* original C++ signature */
+        # Supersampling factor (1 = no supersampling, 2 = render at 2x2 resolution then resolve, etc.)
+        # (read-only: use SetPixelRatio)
+        supersampling: int = 1
+
+        # float MinPixelRatio = 0.25f;    /* original C++ signature */
+        min_pixel_ratio: float = 0.25  # Bounds for the pixel ratio selected by UpdateResolutionTier
+        # float MaxPixelRatio = 4.f;    /* original C++ signature */
+        max_pixel_ratio: float = 4.0
+
         # NvgFramebuffer(    /* original C++ signature */
         #             NVGcontext *vg,
         #             int width, int height,
-        #             int nvgImageFlags
+        #             int nvgImageFlags,
+        #             float pixelRatio = -1.f,
+        #             int supersampling = 1
         #             );
-        def __init__(self, vg: Context, width: int, height: int, nvg_image_flags: int) -> None:
-            """ See NVGimageFlags"""
+        def __init__(
+            self,
+            vg: Context,
+            width: int,
+            height: int,
+            nvg_image_flags: int,
+            pixel_ratio: float = -1.0,
+            supersampling: int = 1,
+        ) -> None:
+            """ Warning: this constructor can be called only after a valid renderer backend (OpenGL) has been created
+             (will call Init())
+             If pixelRatio <= 0, ImGui::GetIO().DisplayFramebufferScale.x will be used
+            """
             pass
 
 
@@ -1252,7 +1281,33 @@ class nvg_imgui:  # Proxy class that introduces typings for the *submodule* nvg_
 
         # void Unbind();    /* original C++ signature */
         def unbind(self) -> None:
-            """ Restore the previous render target"""
+            """ Restore the previous render target
+             (if supersampling is active, this will also resolve the drawing into the texture)
+            """
+            pass
+
+        # int TextureWidth() const;    /* original C++ signature */
+        def texture_width(self) -> int:
+            """ Size of the texture in pixels"""
+            pass
+        # int TextureHeight() const;    /* original C++ signature */
+        def texture_height(self) -> int:
+            pass
+
+        # void SetPixelRatio(float pixelRatio, int supersampling = 1);    /* original C++ signature */
+        def set_pixel_ratio(self, pixel_ratio: float, supersampling: int = 1) -> None:
+            """ Change the pixel ratio and/or supersampling (will reallocate the texture if they changed)"""
+            pass
+
+        # bool UpdateResolutionTier(ImVec2 displayedSize);    /* original C++ signature */
+        def update_resolution_tier(self, displayed_size: ImVec2Like) -> bool:
+            """ Select a resolution tier from the size at which the texture is displayed on screen
+             (in ImGui coordinates, e.g. the size passed to ImGui::Image).
+             Tiers are powers of two (..., 0.5, 1, 2, 4) of the ratio between on-screen pixels and drawing units,
+             clamped to [MinPixelRatio, MaxPixelRatio].
+             The texture is reallocated only when the tier changes, not on every resize.
+             Returns True if the texture was reallocated (in which case it needs to be redrawn).
+            """
             pass
 
 
@@ -1449,6 +1504,128 @@ def text_line_height(ctx: Context, line_height: float) -> None:
 def image_size(ctx: Context, image: int) -> Tuple[int, int]:
     """ Returns the dimensions of a created image."""
     pass
+
+
+# ---------------------------------------------------------------------------------------------------------------------
+#                      Text layout cache
+# ---------------------------------------------------------------------------------------------------------------------
+# NvgTextLayoutCache caches the result of TextBreakLines and TextBoxBounds for texts that are drawn
+# at each frame (e.g. chart ticks and annotations).
+# Entries are keyed by (text style, scale of the current transform, break width, text),
+# and evicted when unused for MaxUnusedFrames frames.
+#
+# The text style is applied to the context by each call (nvgFontFaceId, nvgFontSize, nvgTextLetterSpacing,
+# nvgTextLineHeight and nvgTextAlign), and stays set afterward.
+# Call Clear() if the device pixel ratio passed to nvgBeginFrame changes.
+
+
+class NvgTextStyleKey:
+    """ The part of the text style that affects the layout"""
+    # int fontId = -1;    /* original C++ signature */
+    font_id: int = -1  # As returned by nvgCreateFont / nvgFindFont
+    # float fontSize = 0.f;    /* original C++ signature */
+    font_size: float = 0.0
+    # float letterSpacing = 0.f;    /* original C++ signature */
+    letter_spacing: float = 0.0
+    # float lineHeight = 1.f;    /* original C++ signature */
+    line_height: float = 1.0  # Proportional line height (see nvgTextLineHeight)
+    # int align = NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE;    /* original C++ signature */
+    align: int = 65  # NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE
+    # NvgTextStyleKey(int fontId = -1, float fontSize = 0.f, float letterSpacing = 0.f, float lineHeight = 1.f, int align = NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE);    /* original C++ signature */
+    def __init__(
+        self,
+        font_id: int = -1,
+        font_size: float = 0.0,
+        letter_spacing: float = 0.0,
+        line_height: float = 1.0,
+        align: int = 65  # NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE
+        ) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+
+class NvgTextRowSpan:
+    """ A row of a cached layout, stored as byte offsets inside NvgTextLayout::text (no string copy)"""
+    # int start = 0,     /* original C++ signature */
+    start: int = 0  # Byte offsets of the row inside the text
+    # end = 0;    /* original C++ signature */
+    end: int = 0    # Byte offsets of the row inside the text
+    # float width = 0.f;    /* original C++ signature */
+    width: float = 0.0  # Logical width of the row.
+    # float minx = 0.f,     /* original C++ signature */
+    minx: float = 0.0   # Actual bounds of the row.
+    # maxx = 0.f;    /* original C++ signature */
+    maxx: float = 0.0   # Actual bounds of the row.
+    def __init__(self) -> None:
+        pass
+
+
+class NvgTextLayout:
+    """ The cached layout of a text"""
+    # std::string text;    /* original C++ signature */
+    text: str
+    # float breakRowWidth = 0.f;    /* original C++ signature */
+    break_row_width: float = 0.0
+    # std::vector<NvgTextRowSpan> rows;    /* original C++ signature */
+    rows: List[NvgTextRowSpan]
+    # Bounds boxBounds = {};    /* original C++ signature */
+    box_bounds: Bounds  # Bounds of the text box, when drawn at (0, 0)
+    # float lineh = 0.f;    /* original C++ signature */
+    lineh: float = 0.0  # Line height in local coordinate space (see nvgTextMetrics)
+
+
+class NvgTextLayoutCache:
+    # int MaxUnusedFrames = 60;    /* original C++ signature */
+    max_unused_frames: int = 60  # Entries unused for more than MaxUnusedFrames frames are evicted by NewFrame()
+
+    def __init__(self) -> None:
+        pass
+
+    # std::shared_ptr<const NvgTextLayout> Layout(    /* original C++ signature */
+    #         NVGcontext* ctx, const NvgTextStyleKey& style, const std::string& text, float breakRowWidth);
+    def layout(self, ctx: Context, style: NvgTextStyleKey, text: str, break_row_width: float) -> NvgTextLayout:
+        """ Applies the text style to the context, and returns the layout of the text (rows + box bounds),
+         computing it on cache misses.
+         The returned layout is shared, and stays valid even if the entry is evicted later.
+        """
+        pass
+
+    # Bounds TextBoxBounds(    /* original C++ signature */
+    #         NVGcontext* ctx, const NvgTextStyleKey& style, float x, float y, float breakRowWidth, const std::string& text);
+    def text_box_bounds(
+        self, ctx: Context, style: NvgTextStyleKey, x: float, y: float, break_row_width: float, text: str
+        ) -> Bounds:
+        """ Same as nvgcpp_TextBoxBounds, using the cached layout"""
+        pass
+
+    # void TextBox(    /* original C++ signature */
+    #         NVGcontext* ctx, const NvgTextStyleKey& style, float x, float y, float breakRowWidth, const std::string& text);
+    def text_box(
+        self, ctx: Context, style: NvgTextStyleKey, x: float, y: float, break_row_width: float, text: str
+        ) -> None:
+        """ Same as nvgcpp_TextBox, using the cached layout (the text is not broken again)"""
+        pass
+
+    # void NewFrame();    /* original C++ signature */
+    def new_frame(self) -> None:
+        """ Call once per frame: evicts unused entries, and resets the per frame counters"""
+        pass
+
+    # void Clear();    /* original C++ signature */
+    def clear(self) -> None:
+        """ Removes all entries (call it when fonts are reloaded)"""
+        pass
+
+    # size_t Size() const { return mEntries.size(); }    /* original C++ signature */
+    def size(self) -> int:
+        pass
+    # int FrameReuseCount() const { return mFrameReuseCount; }    /* original C++ signature */
+    def frame_reuse_count(self) -> int:
+        """ Number of cache hits / misses since the last call to NewFrame()"""
+        pass
+    # int FrameMissCount() const { return mFrameMissCount; }    /* original C++ signature */
+    def frame_miss_count(self) -> int:
+        pass
 ####################    </generated_from:nvg_cpp_text.h>    ####################
 
 # </litgen_stub> // Autogenerated code end!
@@ -2,7 +2,7 @@
 - Will display a screenshot of the final app state in the notebook output.
 - Will use a white theme for the GUI.
 - Will make the window autosize by default.
-- Will patch hello_imgui.run and immapp.run
+- Will patch hello_imgui.run or immapp.run
 """
 
 def is_in_notebook() -> bool:
@@ -13,11 +13,11 @@ def is_in_notebook() -> bool:
         return False
 
 
-def notebook_do_patch_runners_if_needed() -> None:
+def notebook_do_patch_runners_if_needed(runner_module) -> None:
+    """Patch runner_module.run (runner_module is hello_imgui or immapp)"""
     if not is_in_notebook():
         return
 
-    from imgui_bundle import immapp, hello_imgui
     from imgui_bundle.immapp.immapp_notebook import _run_app_function_and_display_image_in_notebook
 
     def patch_runner(run_backup):
@@ -47,8 +47,5 @@ def notebook_do_patch_runners_if_needed() -> None:
             _run_app_function_and_display_image_in_notebook(app_function)
         return patched_run
 
-    immapp.run_original = immapp.run
-    immapp.run = patch_runner(immapp.run_original)  # noqa
-
-    hello_imgui.run_original = hello_imgui.run
-    hello_imgui.run = patch_runner(hello_imgui.run_original)  # noqa
+    runner_module.run_original = runner_module.run
+    runner_module.run = patch_runner(runner_module.run_original)  # noqa
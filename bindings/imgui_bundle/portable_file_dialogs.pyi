@@ -5,10 +5,12 @@ https://github.com/samhocevar/portable-file-dialogs
 # ruff: noqa: B008
 import enum
 
-from typing import List, Optional
+from typing import Callable, List, Optional
 
-# Process wait timeout, in milliseconds
-default_wait_timeout = 20
+# Process wait timeout, in milliseconds. By default, ready() only checks
+# for completion and never blocks the caller: use a positive value to
+# wait at most this duration, or -1 to wait until the process completes.
+default_wait_timeout = 0
 
 # !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!  AUTOGENERATED CODE !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 # <litgen_stub> // Autogenerated code below! Do not edit!
@@ -65,6 +67,13 @@ class notify:
     def kill(self) -> bool:
         pass
 
+    def on_ready(self, callback: Callable[[], None]) -> None:
+        """Register a callback that is invoked once when the dialog completes
+        (it is called from ready() or result(), on the thread that polls the dialog;
+        it is not called if the dialog is destroyed before completing)
+        """
+        pass
+
 class message:
     """
     The message widget
@@ -89,6 +98,13 @@ class message:
     def kill(self) -> bool:
         pass
 
+    def on_ready(self, callback: Callable[[], None]) -> None:
+        """Register a callback that is invoked once when the dialog completes
+        (it is called from ready() or result(), on the thread that polls the dialog;
+        it is not called if the dialog is destroyed before completing)
+        """
+        pass
+
 def all_files_filter() -> List[str]:
     pass
 
@@ -116,6 +132,13 @@ class open_file:
     def kill(self) -> bool:
         pass
 
+    def on_ready(self, callback: Callable[[], None]) -> None:
+        """Register a callback that is invoked once when the dialog completes
+        (it is called from ready() or result(), on the thread that polls the dialog;
+        it is not called if the dialog is destroyed before completing)
+        """
+        pass
+
     def result(self) -> List[str]:
         pass
 
@@ -138,6 +161,13 @@ class save_file:
     def kill(self) -> bool:
         pass
 
+    def on_ready(self, callback: Callable[[], None]) -> None:
+        """Register a callback that is invoked once when the dialog completes
+        (it is called from ready() or result(), on the thread that polls the dialog;
+        it is not called if the dialog is destroyed before completing)
+        """
+        pass
+
     def result(self) -> str:
         pass
 
@@ -153,6 +183,13 @@ class select_folder:
     def kill(self) -> bool:
         pass
 
+    def on_ready(self, callback: Callable[[], None]) -> None:
+        """Register a callback that is invoked once when the dialog completes
+        (it is called from ready() or result(), on the thread that polls the dialog;
+        it is not called if the dialog is destroyed before completing)
+        """
+        pass
+
     def result(self) -> str:
         pass
 
@@ -4,7 +4,7 @@ that integrates with the browser's requestAnimationFrame API.
 """
 from dataclasses import dataclass
 from typing import Callable
-from imgui_bundle import hello_imgui, immapp
+from imgui_bundle import hello_imgui
 from enum import Enum
 from pyodide.ffi import create_proxy  # type: ignore
 import js  # type: ignore
@@ -78,6 +78,7 @@ def _arg_to_render_lifecycle_functions(himgui_or_immapp: _HelloImGuiOrImmApp, *a
     if himgui_or_immapp == _HelloImGuiOrImmApp.HELLO_IMGUI:
         render_module = hello_imgui.manual_render
     elif himgui_or_immapp == _HelloImGuiOrImmApp.IMMAPP:
+        from imgui_bundle import immapp
         render_module = immapp.manual_render
     else:
         raise ValueError("Invalid value for himgui_or_immapp")
@@ -152,12 +153,16 @@ class _ManualRenderJs:
 _MANUAL_RENDER_JS: _ManualRenderJs | None = None
 
 
-def pyodide_do_patch_runners():
+def pyodide_do_patch_runners(runner_module) -> None:
+    """Patch runner_module.run (runner_module is hello_imgui or immapp)"""
     # Instantiate global runners
     global _MANUAL_RENDER_JS
-    print("pyodide_do_patch_runners()")
-    _log("_MANUAL_RENDER_JS: Version 1")
-    _MANUAL_RENDER_JS = _ManualRenderJs()
-    # Monkey patch the hello_imgui.run and immapp.run function to use the js version
-    hello_imgui.run = _MANUAL_RENDER_JS.run_hello_imgui
-    immapp.run = _MANUAL_RENDER_JS.run_immapp
+    if _MANUAL_RENDER_JS is None:
+        print("pyodide_do_patch_runners()")
+        _log("_MANUAL_RENDER_JS: Version 1")
+        _MANUAL_RENDER_JS = _ManualRenderJs()
+    # Monkey patch the hello_imgui.run or immapp.run function to use the js version
+    if runner_module.__name__.endswith("hello_imgui"):
+        runner_module.run = _MANUAL_RENDER_JS.run_hello_imgui
+    else:
+        runner_module.run = _MANUAL_RENDER_JS.run_immapp
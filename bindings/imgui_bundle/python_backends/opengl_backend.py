@@ -58,6 +58,9 @@ class ProgrammablePipelineRenderer(BaseOpenGLRenderer):
         self._elements_handle = None
         self._vao_handle = None
 
+        # If True, the command lists are uploaded and drawn by a native loop (imgui.backends.opengl_submit_draw_data)
+        self.native_draw_data_submission = True
+
         super(ProgrammablePipelineRenderer, self).__init__()
 
     def refresh_font_texture(self):
@@ -230,6 +233,24 @@ class ProgrammablePipelineRenderer(BaseOpenGLRenderer):
         gl.glUniformMatrix4fv(self._attrib_proj_mtx, 1, gl.GL_FALSE, ortho_projection)
         gl.glBindVertexArray(self._vao_handle)
 
+        if self.native_draw_data_submission:
+            imgui.backends.opengl_submit_draw_data(
+                draw_data, self._vao_handle, self._vbo_handle, self._elements_handle, fb_height
+            )
+        else:
+            self._submit_draw_data(draw_data, fb_height)
+
+        # restore modified GL state
+        restore_common_gl_state(common_gl_state_tuple)
+
+        gl.glUseProgram(last_program)
+        gl.glActiveTexture(last_active_texture)
+        gl.glBindVertexArray(last_vertex_array)
+        gl.glBindBuffer(gl.GL_ARRAY_BUFFER, last_array_buffer)
+        gl.glBindBuffer(gl.GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer)
+
+    def _submit_draw_data(self, draw_data: imgui.ImDrawData, fb_height: int):
+        """Python version of imgui.backends.opengl_submit_draw_data (slower: several PyOpenGL calls per command)"""
         for commands in draw_data.cmd_lists:
 
             gl.glBindBuffer(gl.GL_ARRAY_BUFFER, self._vbo_handle)
@@ -270,16 +291,6 @@ class ProgrammablePipelineRenderer(BaseOpenGLRenderer):
                     ctypes.c_void_p(command.idx_offset * imgui.INDEX_SIZE),
                 )
 
-
-        # restore modified GL state
-        restore_common_gl_state(common_gl_state_tuple)
-
-        gl.glUseProgram(last_program)
-        gl.glActiveTexture(last_active_texture)
-        gl.glBindVertexArray(last_vertex_array)
-        gl.glBindBuffer(gl.GL_ARRAY_BUFFER, last_array_buffer)
-        gl.glBindBuffer(gl.GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer)
-
     def _invalidate_device_objects(self):
         if self._vao_handle > -1:
             gl.glDeleteVertexArrays(1, [self._vao_handle])
@@ -1,33 +1,262 @@
 // Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#include "ImFileDialogTextureHelper.h"
 #include "ImFileDialog/ImFileDialog.h"
 #include "hello_imgui/hello_imgui_include_opengl.h"
 #include "imgui.h"
 
-void ImFileDialogSetupTextureLoader()
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+
+namespace
 {
-    // ImFileDialog requires you to set the CreateTexture and DeleteTexture
-    ifd::FileDialog::Instance().CreateTexture = [](uint8_t* data, int w, int h, char fmt) -> ImTextureID
+    struct CachedTexture
     {
-        GLuint tex;
+        GLuint TextureId = 0;
+        uint64_t Hash = 0;
+        size_t Bytes = 0;
+        int RefCount = 0;               // Number of icons ImFileDialog currently uses this texture for
+        uint64_t LastReleaseTick = 0;   // Used to evict the least recently released unused textures first
+    };
+
+    struct PendingUpload
+    {
+        GLuint TextureId = 0;
+        int Width = 0, Height = 0;
+        std::vector<uint8_t> Pixels;    // RGBA
+    };
+
+    struct ThumbnailTextureCache
+    {
+        ImFileDialogThumbnailParams Params;
+        std::unordered_map<uint64_t, GLuint> TextureIdByHash;
+        std::unordered_map<GLuint, CachedTexture> Textures;
+        std::deque<PendingUpload> PendingUploads;
+        // References that ImFileDialog still held when the cache was cleared: their GL names
+        // were already deleted (and may since have been reused), so releasing them must be a no-op
+        std::unordered_map<GLuint, int> StaleRefCounts;
+        size_t UnusedBytes = 0;
+        uint64_t Tick = 0;
+    };
+
+    ThumbnailTextureCache gThumbnailCache;
+
+
+    // Converts to RGBA, and downscales so that the largest side is at most maxSize.
+    // The box filter is approximated with 2x2 samples per destination pixel: its cost depends
+    // only on the thumbnail size, not on the size of the (possibly huge) source image.
+    std::vector<uint8_t> MakeRgbaThumbnail(const uint8_t* data, int w, int h, bool isBgra, int maxSize, int* outW, int* outH)
+    {
+        float scale = std::min(1.f, (float)maxSize / (float)std::max(w, h));
+        int dw = std::max(1, (int)((float)w * scale));
+        int dh = std::max(1, (int)((float)h * scale));
+        *outW = dw;
+        *outH = dh;
+
+        std::vector<uint8_t> pixels((size_t)dw * (size_t)dh * 4);
+        const int r = isBgra ? 2 : 0, b = isBgra ? 0 : 2;
+        for (int dy = 0; dy < dh; ++dy)
+        {
+            int sy0 = std::min(h - 1, (int)(((float)dy + 0.25f) * (float)h / (float)dh));
+            int sy1 = std::min(h - 1, (int)(((float)dy + 0.75f) * (float)h / (float)dh));
+            for (int dx = 0; dx < dw; ++dx)
+            {
+                int sx0 = std::min(w - 1, (int)(((float)dx + 0.25f) * (float)w / (float)dw));
+                int sx1 = std::min(w - 1, (int)(((float)dx + 0.75f) * (float)w / (float)dw));
+                const uint8_t* s00 = data + ((size_t)sy0 * w + sx0) * 4;
+                const uint8_t* s01 = data + ((size_t)sy0 * w + sx1) * 4;
+                const uint8_t* s10 = data + ((size_t)sy1 * w + sx0) * 4;
+                const uint8_t* s11 = data + ((size_t)sy1 * w + sx1) * 4;
+                uint8_t* d = pixels.data() + ((size_t)dy * dw + dx) * 4;
+                d[0] = (uint8_t)((s00[r] + s01[r] + s10[r] + s11[r] + 2) / 4);
+                d[1] = (uint8_t)((s00[1] + s01[1] + s10[1] + s11[1] + 2) / 4);
+                d[2] = (uint8_t)((s00[b] + s01[b] + s10[b] + s11[b] + 2) / 4);
+                d[3] = (uint8_t)((s00[3] + s01[3] + s10[3] + s11[3] + 2) / 4);
+            }
+        }
+        return pixels;
+    }
+
+    uint64_t HashThumbnail(const std::vector<uint8_t>& pixels, int w, int h)
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        auto feed = [&hash](uint8_t v) { hash = (hash ^ v) * 1099511628211ull; };
+        for (int i = 0; i < 4; ++i)
+        {
+            feed((uint8_t)(w >> (8 * i)));
+            feed((uint8_t)(h >> (8 * i)));
+        }
+        for (uint8_t v : pixels)
+            feed(v);
+        return hash;
+    }
+
+    void DeleteCachedTexture(GLuint textureId)
+    {
+        auto& cache = gThumbnailCache;
+        auto it = cache.Textures.find(textureId);
+        if (it == cache.Textures.end())
+            return;
+        if (it->second.RefCount == 0)
+            cache.UnusedBytes -= it->second.Bytes;
+        cache.TextureIdByHash.erase(it->second.Hash);
+        cache.Textures.erase(it);
+
+        cache.PendingUploads.erase(
+            std::remove_if(cache.PendingUploads.begin(), cache.PendingUploads.end(),
+                           [textureId](const PendingUpload& p) { return p.TextureId == textureId; }),
+            cache.PendingUploads.end());
+        glDeleteTextures(1, &textureId);
+    }
+
+    void TrimUnusedTextures()
+    {
+        auto& cache = gThumbnailCache;
+        while (cache.UnusedBytes > cache.Params.UnusedCacheBudgetBytes)
+        {
+            const CachedTexture* oldest = nullptr;
+            for (const auto& kv : cache.Textures)
+                if (kv.second.RefCount == 0 && (oldest == nullptr || kv.second.LastReleaseTick < oldest->LastReleaseTick))
+                    oldest = &kv.second;
+            if (oldest == nullptr)
+                break;
+            DeleteCachedTexture(oldest->TextureId);
+        }
+    }
+
+    ImTextureID CreateThumbnailTexture(uint8_t* data, int w, int h, char fmt)
+    {
+        auto& cache = gThumbnailCache;
+
+        int tw, th;
+        // fmt == 0 => BGRA, fmt == 1 => RGBA
+        std::vector<uint8_t> pixels = MakeRgbaThumbnail(data, w, h, fmt == 0, cache.Params.MaxThumbnailSize, &tw, &th);
+        uint64_t hash = HashThumbnail(pixels, tw, th);
+
+        // Reuse an existing texture if this thumbnail was already seen (e.g. when going back to a directory)
+        auto itHash = cache.TextureIdByHash.find(hash);
+        if (itHash != cache.TextureIdByHash.end())
+        {
+            CachedTexture& cached = cache.Textures[itHash->second];
+            if (cached.RefCount == 0)
+                cache.UnusedBytes -= cached.Bytes;
+            ++cached.RefCount;
+            return (ImTextureID)(size_t)cached.TextureId;
+        }
 
+        GLuint tex;
         glGenTextures(1, &tex);
         glBindTexture(GL_TEXTURE_2D, tex);
+        // No mipmaps: they are not used with GL_NEAREST filtering
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-#if !defined(__EMSCRIPTEN__) && !defined(__ANDROID__)
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, (fmt == 0) ? GL_BGRA : GL_RGBA, GL_UNSIGNED_BYTE, data);
-#endif
-        glGenerateMipmap(GL_TEXTURE_2D);
+        // Transparent placeholder, until the thumbnail is uploaded by ImFileDialogProcessPendingTextureUploads()
+        const uint8_t transparentPixel[4] = {0, 0, 0, 0};
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, transparentPixel);
         glBindTexture(GL_TEXTURE_2D, 0);
 
+        CachedTexture cached;
+        cached.TextureId = tex;
+        cached.Hash = hash;
+        cached.Bytes = pixels.size();
+        cached.RefCount = 1;
+        cache.Textures[tex] = cached;
+        cache.TextureIdByHash[hash] = tex;
+
+        PendingUpload upload;
+        upload.TextureId = tex;
+        upload.Width = tw;
+        upload.Height = th;
+        upload.Pixels = std::move(pixels);
+        cache.PendingUploads.push_back(std::move(upload));
+
         return (ImTextureID)(size_t)tex;
-    };
+    }
 
-    ifd::FileDialog::Instance().DeleteTexture = [](ImTextureID tex)
+    void ReleaseThumbnailTexture(ImTextureID tex)
     {
+        auto& cache = gThumbnailCache;
         GLuint texID = (GLuint)((uintptr_t)tex);
-        glDeleteTextures(1, &texID);
-    };
+        auto itStale = cache.StaleRefCounts.find(texID);
+        if (itStale != cache.StaleRefCounts.end())
+        {
+            if (--itStale->second == 0)
+                cache.StaleRefCounts.erase(itStale);
+            return;
+        }
+        // All the textures we create are in the cache: never delete a texture we do not own
+        auto it = cache.Textures.find(texID);
+        if (it == cache.Textures.end())
+            return;
+
+        // Keep the texture in the cache: it may be reused when coming back to this directory
+        CachedTexture& cached = it->second;
+        if (cached.RefCount > 0 && --cached.RefCount == 0)
+        {
+            cache.UnusedBytes += cached.Bytes;
+            cached.LastReleaseTick = ++cache.Tick;
+            TrimUnusedTextures();
+        }
+    }
+}
+
+
+ImFileDialogThumbnailParams& ImFileDialogGetThumbnailParams()
+{
+    return gThumbnailCache.Params;
+}
+
+
+void ImFileDialogProcessPendingTextureUploads()
+{
+    auto& cache = gThumbnailCache;
+    if (cache.PendingUploads.empty())
+        return;
+
+    size_t uploadedBytes = 0;
+    while (!cache.PendingUploads.empty())
+    {
+        PendingUpload& upload = cache.PendingUploads.front();
+        // Always upload at least one thumbnail per frame
+        if (uploadedBytes > 0 && uploadedBytes + upload.Pixels.size() > cache.Params.UploadBudgetBytesPerFrame)
+            break;
+
+        glBindTexture(GL_TEXTURE_2D, upload.TextureId);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, upload.Width, upload.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, upload.Pixels.data());
+        uploadedBytes += upload.Pixels.size();
+        cache.PendingUploads.pop_front();
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+
+void ImFileDialogClearTextureCache()
+{
+    auto& cache = gThumbnailCache;
+    for (auto& kv : cache.Textures)
+    {
+        if (kv.second.RefCount > 0)
+            cache.StaleRefCounts[kv.second.TextureId] += kv.second.RefCount;
+        glDeleteTextures(1, &kv.second.TextureId);
+    }
+    cache.Textures.clear();
+    cache.TextureIdByHash.clear();
+    cache.PendingUploads.clear();
+    cache.UnusedBytes = 0;
+}
+
+
+void ImFileDialogSetupTextureLoader()
+{
+    // ImFileDialog requires you to set the CreateTexture and DeleteTexture
+    // (ImFileDialog decodes the image previews in its own loader thread, and calls CreateTexture from the render thread.
+    // It frees the decoded image as soon as CreateTexture returns, so the downscale has to run there)
+    ifd::FileDialog::Instance().CreateTexture = CreateThumbnailTexture;
+    ifd::FileDialog::Instance().DeleteTexture = ReleaseThumbnailTexture;
 }
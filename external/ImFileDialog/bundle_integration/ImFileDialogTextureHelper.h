@@ -1,2 +1,27 @@
 // Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#pragma once
+#include <cstddef>
+
+// Sets ImFileDialog CreateTexture and DeleteTexture callbacks.
+// Thumbnails are downscaled to at most ImFileDialogThumbnailParams::MaxThumbnailSize pixels,
+// their upload to the GPU is deferred to ImFileDialogProcessPendingTextureUploads(),
+// and their textures are kept in a bounded cache, so that they can be reused across directory changes.
 void ImFileDialogSetupTextureLoader();
+
+struct ImFileDialogThumbnailParams
+{
+    // Thumbnails larger than this (in pixels) are downscaled before being uploaded
+    int MaxThumbnailSize = 256;
+    // Maximum number of bytes uploaded to the GPU per frame
+    size_t UploadBudgetBytesPerFrame = 4 * 1024 * 1024;
+    // Maximum number of bytes kept in textures that ImFileDialog does not use anymore
+    size_t UnusedCacheBudgetBytes = 64 * 1024 * 1024;
+};
+ImFileDialogThumbnailParams& ImFileDialogGetThumbnailParams();
+
+// Uploads pending thumbnails, within the per frame upload budget (call it once per frame)
+void ImFileDialogProcessPendingTextureUploads();
+
+// Deletes all cached textures (call it before the OpenGL context is destroyed).
+// The thumbnails ImFileDialog still references are then ignored when it releases them.
+void ImFileDialogClearTextureCache();
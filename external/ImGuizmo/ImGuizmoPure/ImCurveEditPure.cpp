@@ -6,24 +6,49 @@ namespace ImCurveEdit
 {
     size_t DelegatePure::GetPointCount(size_t curveIndex)
     {
-        return GetPointsList(curveIndex).size();
+        return PointsList(curveIndex).size();
     }
 
     ImVec2* DelegatePure::GetPoints(size_t curveIndex)
     {
-        return GetPointsList(curveIndex).data();
+        return PointsList(curveIndex).data();
+    }
+
+    void DelegatePure::SnapshotPointsLists()
+    {
+        size_t curveCount = GetCurveCount();
+        mPointsListsSnapshot.resize(curveCount);
+        for (size_t i = 0; i < curveCount; ++i)
+            mPointsListsSnapshot[i] = &GetPointsList(i);
+        mHasPointsListsSnapshot = true;
+    }
+
+    std::vector<ImVec2>& DelegatePure::PointsList(size_t curveIndex)
+    {
+        // We keep pointers to the lists (not copies of their points), so that the snapshot
+        // stays up to date when EditPoint or AddPoint modify a list during the edition
+        if (mHasPointsListsSnapshot && curveIndex < mPointsListsSnapshot.size())
+            return *mPointsListsSnapshot[curveIndex];
+        return GetPointsList(curveIndex);
     }
 
     Editable<SelectedPoints> EditPure(
         DelegatePure& delegate, const ImVec2& size, unsigned int id, const ImRect* clippingRect)
     {
+        // Drop the snapshot when leaving, even if Edit throws (e.g. from a Python delegate):
+        // otherwise the next calls would use dangling list pointers
+        struct SnapshotGuard
+        {
+            DelegatePure& delegate;
+            ~SnapshotGuard() { delegate.mHasPointsListsSnapshot = false; }
+        };
+        delegate.SnapshotPointsLists();
+        SnapshotGuard snapshotGuard{delegate};
+
         ImVector<EditPoint> editedPoints;
         int r = Edit(delegate, size, id, clippingRect, &editedPoints);
 
-        std::vector<EditPoint> editedPointsStl;
-        for (const auto& v: editedPoints)
-            editedPointsStl.push_back(v);
-
+        std::vector<EditPoint> editedPointsStl(editedPoints.begin(), editedPoints.end());
         return Editable(editedPointsStl, r > 0);
     }
 
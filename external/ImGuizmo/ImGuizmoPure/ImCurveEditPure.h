@@ -12,9 +12,20 @@ namespace ImCurveEdit
        size_t GetPointCount(size_t curveIndex) override;
        ImVec2* GetPoints(size_t curveIndex) override;
 
+       // During EditPure, GetPointsList is called only once per curve: ImCurveEdit queries the points
+       // many times per frame, and the returned lists are reused for all those queries.
+       // The returned references must therefore stay valid (and refer to the same lists) until EditPure returns.
        virtual std::vector<ImVec2>& GetPointsList(size_t curveIndex) = 0;
 
        virtual ~DelegatePure() = default;
+
+   private:
+       friend Editable<std::vector<EditPoint>> EditPure(DelegatePure&, const ImVec2&, unsigned int, const ImRect*);
+       void SnapshotPointsLists();
+       std::vector<ImVec2>& PointsList(size_t curveIndex);
+
+       std::vector<std::vector<ImVec2>*> mPointsListsSnapshot;
+       bool mHasPointsListsSnapshot = false;
    };
 
     using SelectedPoints = std::vector<EditPoint>;
@@ -26,15 +26,100 @@ namespace IMGUIZMO_NAMESPACE
         return r;
     }
 
+    namespace
+    {
+        // a = b * c (ImGuizmo matrices are row major, and transform row vectors)
+        void MultiplyMatrices(const float* b, const float* c, float* a)
+        {
+            for (int row = 0; row < 4; ++row)
+                for (int col = 0; col < 4; ++col)
+                {
+                    float v = 0.f;
+                    for (int k = 0; k < 4; ++k)
+                        v += b[row * 4 + k] * c[k * 4 + col];
+                    a[row * 4 + col] = v;
+                }
+        }
+
+        // The 6 planes (a, b, c, d) of the frustum of a view projection matrix, normalized so that
+        // a * x + b * y + c * z + d is the signed distance of a world point to the plane (positive inside).
+        // The near plane uses -w <= z, which is conservative for [0, 1] and reversed depth ranges.
+        void ComputeFrustumPlanes(const float* viewProjection, float planes[6][4])
+        {
+            for (int iPlane = 0; iPlane < 6; ++iPlane)
+            {
+                int axis = iPlane / 2;
+                float sign = (iPlane % 2 == 0) ? 1.f : -1.f;
+                for (int i = 0; i < 4; ++i)
+                    planes[iPlane][i] = viewProjection[i * 4 + 3] + sign * viewProjection[i * 4 + axis];
+                float length = sqrtf(planes[iPlane][0] * planes[iPlane][0] + planes[iPlane][1] * planes[iPlane][1] + planes[iPlane][2] * planes[iPlane][2]);
+                if (length > 0.f)
+                    for (float& v : planes[iPlane])
+                        v /= length;
+            }
+        }
+
+        // ImGuizmo draws a unit cube centered on the origin: test its bounding sphere, in world space
+        bool IsCubeInFrustum(const float* matrix, const float planes[6][4])
+        {
+            float maxAxisLengthSquared = 0.f;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const float* r = &matrix[axis * 4];
+                maxAxisLengthSquared = ImMax(maxAxisLengthSquared, r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+            }
+            const float radius = 0.5f * sqrtf(3.f * maxAxisLengthSquared);
+            for (int iPlane = 0; iPlane < 6; ++iPlane)
+            {
+                const float* p = planes[iPlane];
+                float distance = p[0] * matrix[12] + p[1] * matrix[13] + p[2] * matrix[14] + p[3];
+                if (distance < -radius)
+                    return false;
+            }
+            return true;
+        }
+
+        // Matrices of the visible cubes, kept between frames to avoid reallocations
+        std::vector<float> gVisibleCubeMatrices;
+    }
+
     void DrawCubes(const Matrix16& view, const Matrix16& projection, const std::vector<Matrix16> & matrices)
     {
-        std::vector<float> matrices_continuous_guts;
-        matrices_continuous_guts.reserve(16 * matrices.size());
-        for (auto m: matrices)
-            for(size_t i = 0; i < 16; ++i)
-                matrices_continuous_guts.push_back(m.values[i]);
+        // Matrix16 only contains its values, so that the vector storage is already a contiguous buffer of floats
+        static_assert(sizeof(Matrix16) == 16 * sizeof(float), "Matrix16 should only contain 16 floats");
+        if (matrices.empty())
+            return;
+        DrawCubesContiguous(view, projection, matrices.data()->values, (int)matrices.size(), false);
+    }
+
+    void DrawCubesContiguous(const Matrix16& view, const Matrix16& projection, const float* matrices, int matrixCount, bool frustumCulling)
+    {
+        if (matrices == nullptr || matrixCount <= 0)
+            return;
+        if (!frustumCulling)
+        {
+            DrawCubes(view.values, projection.values, matrices, matrixCount);
+            return;
+        }
+
+        float viewProjection[16];
+        MultiplyMatrices(view.values, projection.values, viewProjection);
+        float planes[6][4];
+        ComputeFrustumPlanes(viewProjection, planes);
+
+        gVisibleCubeMatrices.clear();
+        for (int i = 0; i < matrixCount; ++i)
+        {
+            const float* matrix = &matrices[i * 16];
+            if (IsCubeInFrustum(matrix, planes))
+                gVisibleCubeMatrices.insert(gVisibleCubeMatrices.end(), matrix, matrix + 16);
+        }
 
-        DrawCubes(view.values, projection.values, matrices_continuous_guts.data(), (int)matrices.size());
+        int visibleCount = (int)(gVisibleCubeMatrices.size() / 16);
+        if (visibleCount == matrixCount)
+            DrawCubes(view.values, projection.values, matrices, matrixCount);
+        else if (visibleCount > 0)
+            DrawCubes(view.values, projection.values, gVisibleCubeMatrices.data(), visibleCount);
     }
 
     void DrawGrid(const Matrix16& view, const Matrix16& projection, const Matrix16& matrix, const float gridSize)
@@ -60,6 +60,10 @@ namespace IMGUIZMO_NAMESPACE
 
     // Render a cube with face color corresponding to face normal. Usefull for debug/tests
     IMGUI_API void DrawCubes(const Matrix16& view, const Matrix16& projection, const std::vector<Matrix16> & matrices);
+    // Render matrixCount cubes, whose matrices are read in place from a contiguous buffer of matrixCount * 16 floats.
+    // If frustumCulling is true, cubes outside the view frustum are skipped before their faces are sorted and drawn:
+    // use this for scenes with many instances.
+    IMGUI_API void DrawCubesContiguous(const Matrix16& view, const Matrix16& projection, const float* matrices, int matrixCount, bool frustumCulling = true);
     IMGUI_API void DrawGrid(const Matrix16& view, const Matrix16& projection, const Matrix16& matrix, const float gridSize);
 
     // Manipulate may change the objectMatrix parameter (return true if modified)
@@ -305,5 +305,58 @@ void py_init_module_imguizmo(nb::module_& m)
 
     // </litgen_pydef> // Autogenerated code end
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!  AUTOGENERATED CODE END !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+    // Overloads that read (or modify) numpy arrays of 4x4 float32 matrices in place, without copies
+    {
+        nb::module_ pyNsImGuizmo = nb::borrow<nb::module_>(m.attr("im_guizmo"));
+
+        // Returns the number of 4x4 matrices inside a C-contiguous float32 array of shape (..., 4, 4)
+        auto check_matrices_array = [](const nb::ndarray<> & a, const char* param_name) -> int
+        {
+            bool is_float32 = (a.dtype().code == static_cast<uint8_t>(nb::dlpack::dtype_code::Float)) && (a.dtype().bits == 32);
+            if (!is_float32)
+                throw std::runtime_error(std::string("Bad type for param \"") + param_name + "\": expected float32 values");
+            if (a.ndim() < 2 || a.shape(a.ndim() - 1) != 4 || a.shape(a.ndim() - 2) != 4)
+                throw std::runtime_error(std::string("Bad shape for param \"") + param_name + "\": expected (..., 4, 4)");
+            int64_t expected_stride = 1;
+            for (size_t i = a.ndim(); i-- > 0; )
+            {
+                if (a.shape(i) > 1 && a.stride(i) != expected_stride)
+                    throw std::runtime_error(std::string("Param \"") + param_name + "\" must be C-contiguous");
+                expected_stride *= (int64_t)a.shape(i);
+            }
+            return (int)(a.size() / 16);
+        };
+
+        pyNsImGuizmo.def("draw_cubes",
+            [check_matrices_array](const Matrix16& view, const Matrix16& projection, const nb::ndarray<> & matrices, bool frustum_culling)
+            {
+                int matrix_count = check_matrices_array(matrices, "matrices");
+                ImGuizmo::DrawCubesContiguous(view, projection, static_cast<const float *>(matrices.data()), matrix_count, frustum_culling);
+            },
+            nb::arg("view"), nb::arg("projection"), nb::arg("matrices"), nb::arg("frustum_culling") = true,
+            " Render the cubes whose matrices are stored in a C-contiguous float32 array of shape (N, 4, 4), without copying it.\n"
+            " If frustum_culling is True, cubes outside the view frustum are skipped.");
+
+        pyNsImGuizmo.def("manipulate",
+            [check_matrices_array](const Matrix16& view, const Matrix16& projection, ImGuizmo::OPERATION operation, ImGuizmo::MODE mode, nb::ndarray<> & object_matrix, std::optional<Matrix16> delta_matrix, std::optional<Matrix3> snap, std::optional<Matrix6> local_bounds, std::optional<Matrix3> bounds_snap) -> bool
+            {
+                if (check_matrices_array(object_matrix, "object_matrix") != 1)
+                    throw std::runtime_error("Param \"object_matrix\" must contain a single 4x4 matrix");
+                return ImGuizmo::Manipulate(
+                    view.values,
+                    projection.values,
+                    operation,
+                    mode,
+                    static_cast<float *>(object_matrix.data()),
+                    delta_matrix ? delta_matrix->values : NULL,
+                    snap ? snap->values : NULL,
+                    local_bounds ? local_bounds->values : NULL,
+                    bounds_snap ? bounds_snap->values : NULL);
+            },
+            nb::arg("view"), nb::arg("projection"), nb::arg("operation"), nb::arg("mode"), nb::arg("object_matrix"), nb::arg("delta_matrix") = nb::none(), nb::arg("snap") = nb::none(), nb::arg("local_bounds") = nb::none(), nb::arg("bounds_snap") = nb::none(),
+            " Manipulate a float32 array of shape (4, 4) in place (e.g. matrices[i], where matrices has the shape (N, 4, 4)).\n"
+            " Return True if modified");
+    }
 }
 #endif // IMGUI_BUNDLE_WITH_IMGUIZMO
@@ -1,9 +1,13 @@
 // Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#include <chrono>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/string.h>
+#include <nanobind/stl/tuple.h>
 #include <nanobind/stl/vector.h>
 
 namespace nb = nanobind;
@@ -34,139 +38,188 @@ void py_init_module_imcoolbar(nb::module_& m);
 void py_init_module_nanovg(nb::module_& m);
 
 
+// Submodules are registered at import time, but initialized on first attribute access
+// (e.g. `imgui_bundle._imgui_bundle.implot`), since their initialization accounts
+// for most of the import time.
+enum class SubmoduleState { NotInitialized, Initializing, Initialized };
+
+struct SubmoduleInfo
+{
+    std::string Name;                       // e.g. "implot.internal" (as reported in __bundle_submodules__)
+    std::string ParentName;                 // e.g. "implot" (empty for a direct child of _imgui_bundle)
+    std::string AttrName;                   // e.g. "internal" (attribute name inside the parent module)
+    void (*InitFunction)(nb::module_&) = nullptr;
+    std::vector<std::string> Dependencies;  // Submodules whose types are used by this submodule
+
+    SubmoduleState State = SubmoduleState::NotInitialized;
+    double InitDurationSeconds = 0.;
+};
+
 std::vector<std::string> gAllSubmodules;
+std::vector<SubmoduleInfo> gSubmodulesInfos;
+std::string gBundleModuleName;
 
 void _register_submodule(const std::string& submodule_name)
 {
     gAllSubmodules.push_back(submodule_name);
 }
 
+void _register_lazy_submodule(
+    const std::string& submodule_name,
+    const std::string& parent_name,
+    const std::string& attr_name,
+    void (*init_function)(nb::module_&),
+    const std::vector<std::string>& dependencies = {"imgui"})
+{
+    _register_submodule(submodule_name);
+    SubmoduleInfo info;
+    info.Name = submodule_name;
+    info.ParentName = parent_name;
+    info.AttrName = attr_name;
+    info.InitFunction = init_function;
+    info.Dependencies = dependencies;
+    gSubmodulesInfos.push_back(info);
+}
+
+SubmoduleInfo* _find_submodule_info(const std::string& parent_name, const std::string& attr_name)
+{
+    for (auto& info: gSubmodulesInfos)
+        if (info.ParentName == parent_name && info.AttrName == attr_name)
+            return &info;
+    return nullptr;
+}
+
+SubmoduleInfo* _find_submodule_info(const std::string& submodule_name)
+{
+    for (auto& info: gSubmodulesInfos)
+        if (info.Name == submodule_name)
+            return &info;
+    return nullptr;
+}
+
+void _add_lazy_submodules_getattr(nb::module_& module, const std::string& parent_name);
+
+nb::module_ _get_or_init_submodule(SubmoduleInfo& info)
+{
+    nb::module_ parent = info.ParentName.empty()
+        ? nb::module_::import_(gBundleModuleName.c_str())
+        : _get_or_init_submodule(*_find_submodule_info(info.ParentName));
+    if (info.State == SubmoduleState::Initialized)
+        return nb::borrow<nb::module_>(parent.attr(info.AttrName.c_str()));
+    // Reached again while initializing its dependencies (or itself): the dependencies form a cycle
+    if (info.State == SubmoduleState::Initializing)
+        throw std::runtime_error("imgui_bundle: cyclic dependency between lazy submodules, involving " + info.Name);
+
+    info.State = SubmoduleState::Initializing;
+    try
+    {
+        for (const auto& dependency: info.Dependencies)
+            if (SubmoduleInfo* dependency_info = _find_submodule_info(dependency))
+                _get_or_init_submodule(*dependency_info);
+
+        auto start = std::chrono::steady_clock::now();
+        nb::module_ submodule = parent.def_submodule(info.AttrName.c_str());
+        info.InitFunction(submodule);
+        _add_lazy_submodules_getattr(submodule, info.Name);
+        info.InitDurationSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        info.State = SubmoduleState::Initialized;
+        return submodule;
+    }
+    catch (...)
+    {
+        info.State = SubmoduleState::NotInitialized;
+        throw;
+    }
+}
+
+// Adds a module level __getattr__ (PEP 562), which initializes the lazy children submodules
+void _add_lazy_submodules_getattr(nb::module_& module, const std::string& parent_name)
+{
+    bool has_children = false;
+    for (const auto& info: gSubmodulesInfos)
+        if (info.ParentName == parent_name)
+            has_children = true;
+    if (!has_children)
+        return;
+
+    module.def("__getattr__", [parent_name](const std::string& name) -> nb::object {
+        SubmoduleInfo* info = _find_submodule_info(parent_name, name);
+        if (info == nullptr)
+            throw nb::attribute_error(("module has no attribute '" + name + "'").c_str());
+        return _get_or_init_submodule(*info);
+    });
+}
+
 
 void py_init_module_imgui_bundle(nb::module_& m)
 {
     // Disable leak warnings (we may have a few, to be fixed later)
     nb::set_leak_warnings(false);
 
+    gBundleModuleName = nb::cast<std::string>(m.attr("__name__"));
+
     m.def("compilation_time", []() {
         return std::string("imgui_bundle, compiled on ") + __DATE__ + " at " + __TIME__;
     });
 
     // imgui and its submodules
-    _register_submodule("imgui");
-    auto module_imgui =  m.def_submodule("imgui");
-    py_init_module_imgui_main(module_imgui);
-
-    // Submodule imgui.internal
-    _register_submodule("imgui.internal");
-    auto module_imgui_internal =  module_imgui.def_submodule("internal");
-    py_init_module_imgui_internal(module_imgui_internal);
-
-    // Submodule imgui.backends
-    _register_submodule("imgui.backends");
-    auto module_imgui_backends =  module_imgui.def_submodule("backends");
-    py_init_module_imgui_backends(module_imgui_backends);
-
+    _register_lazy_submodule("imgui", "", "imgui", py_init_module_imgui_main, {});
+    _register_lazy_submodule("imgui.internal", "imgui", "internal", py_init_module_imgui_internal);
+    _register_lazy_submodule("imgui.backends", "imgui", "backends", py_init_module_imgui_backends);
 #ifdef HELLOIMGUI_WITH_TEST_ENGINE
-    // Submodule imgui.test_engine
-    _register_submodule("imgui.test_engine");
-    auto module_imgui_test_engine =  module_imgui.def_submodule("test_engine");
-    py_init_module_imgui_test_engine(module_imgui_test_engine);
+    _register_lazy_submodule("imgui.test_engine", "imgui", "test_engine", py_init_module_imgui_test_engine, {"imgui.internal"});
 #endif
 
-    _register_submodule("hello_imgui");
-    auto module_himgui =  m.def_submodule("hello_imgui");
-    py_init_module_hello_imgui(module_himgui);
+    _register_lazy_submodule("hello_imgui", "", "hello_imgui", py_init_module_hello_imgui);
 
 #ifdef IMGUI_BUNDLE_WITH_IMPLOT
-    _register_submodule("implot");
-    auto module_implot =  m.def_submodule("implot");
-    py_init_module_implot(module_implot);
-
-    _register_submodule("implot.internal");
-    auto module_implot_internal = module_implot.def_submodule("internal");
-    py_init_module_implot_internal(module_implot_internal);
+    _register_lazy_submodule("implot", "", "implot", py_init_module_implot);
+    _register_lazy_submodule("implot.internal", "implot", "internal", py_init_module_implot_internal);
 #endif
 
 #ifdef IMGUI_BUNDLE_WITH_IMPLOT3D
-    _register_submodule("implot3d");
-    auto module_implot3d =  m.def_submodule("implot3d");
-    py_init_module_implot3d(module_implot3d);
-
-    _register_submodule("implot3d.internal");
-    auto module_implot3d_internal = module_implot3d.def_submodule("internal");
-    py_init_module_implot3d_internal(module_implot3d_internal);
+    _register_lazy_submodule("implot3d", "", "implot3d", py_init_module_implot3d);
+    _register_lazy_submodule("implot3d.internal", "implot3d", "internal", py_init_module_implot3d_internal);
 #endif
 
-    _register_submodule("imgui_color_text_edit");
-    auto module_imgui_color_text_edit =  m.def_submodule("imgui_color_text_edit");
-    py_init_module_imgui_color_text_edit(module_imgui_color_text_edit);
+    _register_lazy_submodule("imgui_color_text_edit", "", "imgui_color_text_edit", py_init_module_imgui_color_text_edit);
 
 #ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
-    _register_submodule("imgui_node_editor");
-    auto module_imgui_node_editor =  m.def_submodule("imgui_node_editor");
-    py_init_module_imgui_node_editor(module_imgui_node_editor);
+    _register_lazy_submodule("imgui_node_editor", "", "imgui_node_editor", py_init_module_imgui_node_editor);
 #endif
 
-    _register_submodule("imgui_knobs");
-    auto module_imgui_knobs =  m.def_submodule("imgui_knobs");
-    py_init_module_imgui_knobs(module_imgui_knobs);
+    _register_lazy_submodule("imgui_knobs", "", "imgui_knobs", py_init_module_imgui_knobs);
 
 #ifdef IMGUI_BUNDLE_WITH_IMFILEDIALOG
-    _register_submodule("im_file_dialog");
-	auto module_im_file_dialog =  m.def_submodule("im_file_dialog");
-	py_init_module_im_file_dialog(module_im_file_dialog);
+    _register_lazy_submodule("im_file_dialog", "", "im_file_dialog", py_init_module_im_file_dialog);
 #endif
 
-    _register_submodule("imspinner");
-    auto module_imspinner =  m.def_submodule("imspinner");
-    py_init_module_imspinner(module_imspinner);
-
-    _register_submodule("imgui_md");
-    auto module_imgui_md =  m.def_submodule("imgui_md");
-    py_init_module_imgui_md(module_imgui_md);
+    _register_lazy_submodule("imspinner", "", "imspinner", py_init_module_imspinner);
+    _register_lazy_submodule("imgui_md", "", "imgui_md", py_init_module_imgui_md);
 
 #ifdef IMGUI_BUNDLE_WITH_IMMVISION
-    _register_submodule("immvision");
-    auto module_immvision =  m.def_submodule("immvision");
-    py_init_module_immvision(module_immvision);
+    _register_lazy_submodule("immvision", "", "immvision", py_init_module_immvision);
 #endif
 
 #ifdef IMGUI_BUNDLE_WITH_IMGUIZMO
-    _register_submodule("imguizmo");
-    auto module_imguizmo = m.def_submodule("imguizmo");
-    py_init_module_imguizmo(module_imguizmo);
+    _register_lazy_submodule("imguizmo", "", "imguizmo", py_init_module_imguizmo);
 #endif
 
 #ifdef IMGUI_BUNDLE_WITH_IMGUI_TEX_INSPECT
-    _register_submodule("imgui_tex_inspect");
-    auto module_imgui_tex_inspect = m.def_submodule("imgui_tex_inspect");
-    py_init_module_imgui_tex_inspect(module_imgui_tex_inspect);
+    _register_lazy_submodule("imgui_tex_inspect", "", "imgui_tex_inspect", py_init_module_imgui_tex_inspect);
 #endif
 
-    _register_submodule("immapp_cpp");
-    auto module_immapp_cpp = m.def_submodule("immapp_cpp");
-    py_init_module_immapp_cpp(module_immapp_cpp);
+    // immapp_cpp uses HelloImGui runner params, markdown options, and node editor configs
+    _register_lazy_submodule("immapp_cpp", "", "immapp_cpp", py_init_module_immapp_cpp,
+                             {"imgui", "hello_imgui", "imgui_md", "imgui_node_editor"});
 
-    _register_submodule("imgui_toggle");
-    auto module_imgui_toggle = m.def_submodule("imgui_toggle");
-    py_init_module_imgui_toggle(module_imgui_toggle);
-
-    _register_submodule("portable_file_dialogs");
-    auto module_portable_file_dialogs = m.def_submodule("portable_file_dialogs");
-    py_init_module_portable_file_dialogs(module_portable_file_dialogs);
-
-    _register_submodule("imgui_command_palette");
-    auto module_imgui_command_palette = m.def_submodule("imgui_command_palette");
-    py_init_module_imgui_command_palette(module_imgui_command_palette);
-
-    _register_submodule("imcoolbar");
-    auto module_imcooolbar = m.def_submodule("im_cool_bar");
-    py_init_module_imcoolbar(module_imcooolbar);
+    _register_lazy_submodule("imgui_toggle", "", "imgui_toggle", py_init_module_imgui_toggle);
+    _register_lazy_submodule("portable_file_dialogs", "", "portable_file_dialogs", py_init_module_portable_file_dialogs);
+    _register_lazy_submodule("imgui_command_palette", "", "imgui_command_palette", py_init_module_imgui_command_palette);
+    _register_lazy_submodule("imcoolbar", "", "im_cool_bar", py_init_module_imcoolbar);
 
 #ifdef IMGUI_BUNDLE_WITH_NANOVG
-    _register_submodule("nanovg");
-    auto module_nanovg = m.def_submodule("nanovg");
-    py_init_module_nanovg(module_nanovg);
+    _register_lazy_submodule("nanovg", "", "nanovg", py_init_module_nanovg);
 #endif
 
 #ifdef HELLOIMGUI_USE_GLFW3
@@ -174,6 +227,16 @@ void py_init_module_imgui_bundle(nb::module_& m)
 #endif
 
     m.attr("__bundle_submodules__") = gAllSubmodules;
+    _add_lazy_submodules_getattr(m, "");
+
+    // Import time breakdown: the initialization duration of each submodule initialized so far
+    m.def("_submodules_init_durations", []() {
+        std::vector<std::tuple<std::string, double>> r;
+        for (const auto& info: gSubmodulesInfos)
+            if (info.State == SubmoduleState::Initialized)
+                r.push_back({info.Name, info.InitDurationSeconds});
+        return r;
+    });
 
 #ifdef IMGUI_BUNDLE_BUILD_PYODIDE
     m.attr("__bundle_pyodide__") = true;
@@ -38,6 +38,7 @@ def main():
         THIS_DIR
         + "/../imgui-command-palette-py-wrapper/imgui-command-palette-py-wrapper.h"
     )
+    generator.process_cpp_file(THIS_DIR + "/../bundle_integration/imcmd_fuzzy_index.h")
 
     generator.write_generated_code(
         output_cpp_pydef_file=output_cpp_pydef_file,
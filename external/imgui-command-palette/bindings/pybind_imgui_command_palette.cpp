@@ -15,6 +15,7 @@
 
 #include "imgui-command-palette/imcmd_command_palette.h"
 #include "imgui-command-palette-py-wrapper/imgui-command-palette-py-wrapper.h"
+#include "bundle_integration/imcmd_fuzzy_index.h"
 
 namespace nb = nanobind;
 
@@ -135,6 +136,37 @@ void py_init_module_imgui_command_palette(nb::module_& m)
         ;
     ////////////////////    </generated_from:imgui-command-palette-py-wrapper.h>    ////////////////////
 
+
+    ////////////////////    <generated_from:imcmd_fuzzy_index.h>    ////////////////////
+    auto pyClassFuzzyMatch =
+        nb::class_<ImCmd::FuzzyMatch>
+            (m, "FuzzyMatch", "")
+        .def(nb::init<>()) // implicit default constructor
+        .def_rw("name", &ImCmd::FuzzyMatch::Name, "")
+        .def_rw("score", &ImCmd::FuzzyMatch::Score, "")
+        .def_rw("matched_positions", &ImCmd::FuzzyMatch::MatchedPositions, "Byte offsets of the matched characters in Name (e.g. to highlight them)")
+        ;
+
+
+    auto pyClassFuzzyIndex =
+        nb::class_<ImCmd::FuzzyIndex>
+            (m, "FuzzyIndex", " FuzzyIndex: fuzzy search among many names (e.g. tens of thousands of commands), at each keystroke.\n A name matches if the query is a subsequence of it (case insensitive). The scoring uses the same bonuses\n as the command palette (consecutive letters, word starts, camel case, leading letters).\n\n - Each name is stored lowercased in one contiguous buffer, together with a 64 bits mask of its characters:\n   most names are rejected by testing the mask.\n - Search is incremental: when the query extends a previous query (or goes back to it, e.g. with backspace),\n   only the names which matched the previous query are tested.\n - Only the best max_results matches are sorted.")
+        .def(nb::init<>()) // implicit default constructor
+        .def("add_name",
+            &ImCmd::FuzzyIndex::AddName, nb::arg("name"))
+        .def("remove_name",
+            &ImCmd::FuzzyIndex::RemoveName, nb::arg("name"))
+        .def("clear",
+            &ImCmd::FuzzyIndex::Clear)
+        .def("size",
+            &ImCmd::FuzzyIndex::Size)
+        .def("search",
+            &ImCmd::FuzzyIndex::Search,
+            nb::arg("query"), nb::arg("max_results") = 50,
+            "Returns the best matches (at most max_results), best first. An empty query matches all the names.")
+        ;
+    ////////////////////    </generated_from:imcmd_fuzzy_index.h>    ////////////////////
+
     // </litgen_pydef> // Autogenerated code end
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!  AUTOGENERATED CODE END !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 }
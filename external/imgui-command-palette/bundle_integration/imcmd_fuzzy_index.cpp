@@ -0,0 +1,332 @@
+// Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#include "imcmd_fuzzy_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMCMD_FUZZY_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+namespace
+{
+    // Same weights as the command palette scoring (fts_fuzzy_match)
+    constexpr int kSequentialBonus = 15;
+    constexpr int kSeparatorBonus = 30;
+    constexpr int kCamelBonus = 30;
+    constexpr int kFirstLetterBonus = 15;
+    constexpr int kLeadingLetterPenalty = -5;
+    constexpr int kMaxLeadingLetterPenalty = -15;
+    constexpr int kUnmatchedLetterPenalty = -1;
+
+    // The matches of at most this many successive queries are kept
+    constexpr size_t kMaxNarrowingSteps = 64;
+
+    char ToLowerAscii(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
+
+    std::string ToLowerAscii(const std::string& s)
+    {
+        std::string r = s;
+        for (char& c : r)
+            c = ToLowerAscii(c);
+        return r;
+    }
+
+    // One bit per letter and digit, the other bytes share the remaining bits
+    uint64_t CharMask(const char* lowerText, size_t length)
+    {
+        uint64_t mask = 0;
+        for (size_t i = 0; i < length; ++i)
+        {
+            unsigned char c = (unsigned char)lowerText[i];
+            int bit;
+            if (c >= 'a' && c <= 'z')
+                bit = c - 'a';
+            else if (c >= '0' && c <= '9')
+                bit = 26 + (c - '0');
+            else
+                bit = 36 + (c % 28);
+            mask |= (1ULL << bit);
+        }
+        return mask;
+    }
+
+    // Names up to this length are matched with bit masks (the text buffer is padded, so that it can be read by blocks)
+    constexpr size_t kMaxMaskedLength = 64;
+
+    int CountTrailingZeros(uint64_t v)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, v);
+        return (int)index;
+#else
+        return __builtin_ctzll(v);
+#endif
+    }
+
+    int HighestBit(uint64_t v)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, v);
+        return (int)index;
+#else
+        return 63 - __builtin_clzll(v);
+#endif
+    }
+
+    // Bit i is set if text[i] == c, for i < kMaxMaskedLength (text must be readable up to kMaxMaskedLength bytes)
+    uint64_t OccurrenceMask(const char* text, char c)
+    {
+#ifdef IMCMD_FUZZY_SSE2
+        __m128i needle = _mm_set1_epi8(c);
+        uint64_t mask = 0;
+        for (int block = 0; block < 4; ++block)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + block * 16));
+            uint64_t blockMask = (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+            mask |= blockMask << (block * 16);
+        }
+        return mask;
+#else
+        uint64_t mask = 0;
+        for (size_t i = 0; i < kMaxMaskedLength; ++i)
+            mask |= (uint64_t)(text[i] == c) << i;
+        return mask;
+#endif
+    }
+
+    // Finds the positions of the query characters in the text (both lowercase).
+    // Returns false if the query is not a subsequence of the text.
+    // The leftmost end of a match is searched first, then the shortest match which ends there (backward).
+    bool MatchPositions(const char* lowerText, size_t length, const std::string& lowerQuery, int* outPositions)
+    {
+        if (length <= kMaxMaskedLength)
+        {
+            uint64_t lengthMask = length == 64 ? ~0ULL : ((1ULL << length) - 1);
+            // Forward (outPositions temporarily stores the leftmost positions)
+            int pos = -1;
+            for (size_t q = 0; q < lowerQuery.size(); ++q)
+            {
+                if (pos >= 63)
+                    return false;
+                uint64_t candidates = OccurrenceMask(lowerText, lowerQuery[q]) & lengthMask & (~0ULL << (pos + 1));
+                if (candidates == 0)
+                    return false;
+                pos = CountTrailingZeros(candidates);
+                outPositions[q] = pos;
+            }
+            // Backward
+            for (int q = (int)lowerQuery.size() - 2; q >= 0; --q)
+            {
+                uint64_t before = (1ULL << outPositions[q + 1]) - 1;
+                outPositions[q] = HighestBit(OccurrenceMask(lowerText, lowerQuery[(size_t)q]) & before);
+            }
+            return true;
+        }
+
+        // Long names
+        const char* p = lowerText;
+        const char* end = lowerText + length;
+        for (char c : lowerQuery)
+        {
+            const char* found = static_cast<const char*>(memchr(p, c, (size_t)(end - p)));
+            if (found == nullptr)
+                return false;
+            p = found + 1;
+        }
+        int pos = (int)(p - lowerText) - 1;
+        for (int q = (int)lowerQuery.size() - 1; q >= 0; --q)
+        {
+            while (lowerText[pos] != lowerQuery[(size_t)q])
+                --pos;
+            outPositions[q] = pos;
+            --pos;
+        }
+        return true;
+    }
+
+    bool IsSeparator(char c)
+    {
+        return c == ' ' || c == '_' || c == '-' || c == '.' || c == '/' || c == '\\' || c == ':';
+    }
+
+    int ScoreMatch(const char* originalText, size_t length, const int* positions, size_t nbPositions)
+    {
+        int score = 100;
+        score += std::max(kLeadingLetterPenalty * positions[0], kMaxLeadingLetterPenalty);
+        score += kUnmatchedLetterPenalty * (int)(length - nbPositions);
+        for (size_t i = 0; i < nbPositions; ++i)
+        {
+            int pos = positions[i];
+            if (i > 0 && pos == positions[i - 1] + 1)
+                score += kSequentialBonus;
+            if (pos == 0)
+            {
+                score += kFirstLetterBonus;
+                continue;
+            }
+            char previous = originalText[pos - 1], current = originalText[pos];
+            if (previous >= 'a' && previous <= 'z' && current >= 'A' && current <= 'Z')
+                score += kCamelBonus;
+            if (IsSeparator(previous))
+                score += kSeparatorBonus;
+        }
+        return score;
+    }
+
+    // Orders the matches by a single integer: best score first, then shortest name, then first added
+    uint64_t SortKey(int score, size_t length, uint32_t index)
+    {
+        uint64_t clampedScore = (uint64_t)(std::min(std::max(score, -32768), 32767) + 32768);
+        uint64_t lengthRank = 0xFFFF - (uint64_t)std::min(length, (size_t)0xFFFF);
+        return (clampedScore << 48) | (lengthRank << 32) | (uint64_t)(0xFFFFFFFFu - index);
+    }
+
+    uint32_t SortKeyIndex(uint64_t key)
+    {
+        return 0xFFFFFFFFu - (uint32_t)(key & 0xFFFFFFFFu);
+    }
+
+    bool StartsWith(const std::string& s, const std::string& prefix)
+    {
+        return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+    }
+}
+
+
+namespace ImCmd
+{
+    void FuzzyIndex::AddName(const std::string& name)
+    {
+        if (mIndexByName.find(name) != mIndexByName.end())
+            return;
+        uint32_t index = (uint32_t)mCharMasks.size();
+        std::string lowerName = ToLowerAscii(name);
+        mOriginalText += name;
+        mLowerText.resize(mOffsets.back());
+        mLowerText += lowerName;
+        mOffsets.push_back((uint32_t)mLowerText.size());
+        mLowerText.append(kMaxMaskedLength, '\0');
+        mCharMasks.push_back(CharMask(lowerName.data(), lowerName.size()));
+        mIsAlive.push_back(1);
+        mIndexByName[name] = index;
+        // The new name may match the previous queries
+        InvalidateSearches();
+    }
+
+    void FuzzyIndex::RemoveName(const std::string& name)
+    {
+        auto it = mIndexByName.find(name);
+        if (it == mIndexByName.end())
+            return;
+        mIsAlive[it->second] = 0;
+        mIndexByName.erase(it);
+        ++mNbRemoved;
+        InvalidateSearches();
+        CompactIfNeeded();
+    }
+
+    void FuzzyIndex::Clear()
+    {
+        *this = FuzzyIndex();
+    }
+
+    // Rebuilds the buffers without the removed names, once they are the majority
+    void FuzzyIndex::CompactIfNeeded()
+    {
+        if (mNbRemoved < 1024 || mNbRemoved < mIndexByName.size())
+            return;
+        FuzzyIndex compacted;
+        for (size_t i = 0; i < mCharMasks.size(); ++i)
+            if (mIsAlive[i])
+                compacted.AddName(mOriginalText.substr(mOffsets[i], mOffsets[i + 1] - mOffsets[i]));
+        *this = std::move(compacted);
+    }
+
+    std::vector<FuzzyMatch> FuzzyIndex::Search(const std::string& query, int maxResults)
+    {
+        std::vector<FuzzyMatch> results;
+        if (maxResults <= 0)
+            return results;
+
+        if (query.empty())
+        {
+            for (size_t i = 0; i < mCharMasks.size() && (int)results.size() < maxResults; ++i)
+                if (mIsAlive[i])
+                    results.push_back({mOriginalText.substr(mOffsets[i], mOffsets[i + 1] - mOffsets[i]), 0, {}});
+            return results;
+        }
+
+        std::string lowerQuery = ToLowerAscii(query);
+        uint64_t queryMask = CharMask(lowerQuery.data(), lowerQuery.size());
+
+        // Only the names which matched a query that this one extends can match
+        while (!mNarrowingSteps.empty() && !StartsWith(lowerQuery, mNarrowingSteps.back().Query))
+            mNarrowingSteps.pop_back();
+        const std::vector<uint32_t>* candidates = mNarrowingSteps.empty() ? nullptr : &mNarrowingSteps.back().Matches;
+        size_t nbCandidates = candidates != nullptr ? candidates->size() : mCharMasks.size();
+
+        NarrowingStep step;
+        step.Query = lowerQuery;
+        step.Matches.reserve(nbCandidates);
+        // The best matches so far, in a min-heap of sort keys (most candidates are rejected by one comparison)
+        std::vector<uint64_t> bestKeys;
+        bestKeys.reserve((size_t)maxResults + 1);
+        std::vector<int> positions(lowerQuery.size());
+        for (size_t c = 0; c < nbCandidates; ++c)
+        {
+            uint32_t i = candidates != nullptr ? (*candidates)[c] : (uint32_t)c;
+            if ((queryMask & ~mCharMasks[i]) != 0 || !mIsAlive[i])
+                continue;
+            size_t offset = mOffsets[i], length = mOffsets[i + 1] - offset;
+            if (!MatchPositions(mLowerText.data() + offset, length, lowerQuery, positions.data()))
+                continue;
+            step.Matches.push_back(i);
+            int score = ScoreMatch(mOriginalText.data() + offset, length, positions.data(), positions.size());
+            uint64_t key = SortKey(score, length, i);
+            if ((int)bestKeys.size() < maxResults)
+            {
+                bestKeys.push_back(key);
+                std::push_heap(bestKeys.begin(), bestKeys.end(), std::greater<uint64_t>());
+            }
+            else if (key > bestKeys.front())
+            {
+                std::pop_heap(bestKeys.begin(), bestKeys.end(), std::greater<uint64_t>());
+                bestKeys.back() = key;
+                std::push_heap(bestKeys.begin(), bestKeys.end(), std::greater<uint64_t>());
+            }
+        }
+        if (mNarrowingSteps.empty() || mNarrowingSteps.back().Query != lowerQuery)
+        {
+            if (mNarrowingSteps.size() >= kMaxNarrowingSteps)
+                mNarrowingSteps.erase(mNarrowingSteps.begin());
+            mNarrowingSteps.push_back(std::move(step));
+        }
+
+        std::sort(bestKeys.begin(), bestKeys.end(), std::greater<uint64_t>());
+        results.reserve(bestKeys.size());
+        for (uint64_t key : bestKeys)
+        {
+            uint32_t i = SortKeyIndex(key);
+            size_t offset = mOffsets[i], length = mOffsets[i + 1] - offset;
+            FuzzyMatch match;
+            match.Name = mOriginalText.substr(offset, length);
+            match.MatchedPositions.resize(lowerQuery.size());
+            MatchPositions(mLowerText.data() + offset, length, lowerQuery, match.MatchedPositions.data());
+            match.Score = ScoreMatch(mOriginalText.data() + offset, length, match.MatchedPositions.data(), lowerQuery.size());
+            results.push_back(std::move(match));
+        }
+        return results;
+    }
+}
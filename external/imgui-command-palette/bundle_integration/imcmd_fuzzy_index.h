@@ -0,0 +1,61 @@
+// Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ImCmd
+{
+    struct FuzzyMatch
+    {
+        std::string Name;
+        int Score = 0;
+        // Byte offsets of the matched characters in Name (e.g. to highlight them)
+        std::vector<int> MatchedPositions;
+    };
+
+    // FuzzyIndex: fuzzy search among many names (e.g. tens of thousands of commands), at each keystroke.
+    // A name matches if the query is a subsequence of it (case insensitive). The scoring uses the same bonuses
+    // as the command palette (consecutive letters, word starts, camel case, leading letters).
+    //
+    // - Each name is stored lowercased in one contiguous buffer, together with a 64 bits mask of its characters:
+    //   most names are rejected by testing the mask.
+    // - Search is incremental: when the query extends a previous query (or goes back to it, e.g. with backspace),
+    //   only the names which matched the previous query are tested.
+    // - Only the best maxResults matches are sorted.
+    class FuzzyIndex
+    {
+    public:
+        void AddName(const std::string& name);
+        void RemoveName(const std::string& name);
+        void Clear();
+        size_t Size() const { return mIndexByName.size(); }
+
+        // Returns the best matches (at most maxResults), best first. An empty query matches all the names.
+        std::vector<FuzzyMatch> Search(const std::string& query, int maxResults = 50);
+
+    private:
+        struct NarrowingStep
+        {
+            std::string Query;
+            std::vector<uint32_t> Matches;
+        };
+
+        void CompactIfNeeded();
+        void InvalidateSearches() { mNarrowingSteps.clear(); }
+
+        std::string mOriginalText;   // All the names, contiguous
+        std::string mLowerText;      // Same, lowercased
+        std::vector<uint32_t> mOffsets = {0};  // Name i is [mOffsets[i], mOffsets[i + 1])
+        std::vector<uint64_t> mCharMasks;
+        std::vector<uint8_t> mIsAlive;
+        size_t mNbRemoved = 0;
+        std::unordered_map<std::string, uint32_t> mIndexByName;
+
+        // Matches of the previous queries, each query extending the previous one
+        std::vector<NarrowingStep> mNarrowingSteps;
+    };
+}
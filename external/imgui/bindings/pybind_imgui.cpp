@@ -7844,6 +7844,52 @@ void py_init_module_imgui_main(nb::module_& m)
 }
 
 
+// Zero-copy numpy views of ImVector buffers:
+// the returned arrays share the vector memory (they become invalid if the vector is resized or freed),
+// and keep the python ImVector object (and thus its owner, e.g. an ImDrawList) alive.
+template<typename T, typename Scalar>
+void add_imvector_numpy_view(size_t nb_scalars_per_item)
+{
+    static_assert(sizeof(T) % sizeof(Scalar) == 0, "T should be made of Scalar values");
+    nb::handle cls = nb::type<ImVector<T>>();
+    nb::cpp_function_def(
+        [nb_scalars_per_item](ImVector<T>& self) -> nb::ndarray<nb::numpy, Scalar>
+        {
+            nb::object owner = nb::cast(&self, nb::rv_policy::reference);
+            if (nb_scalars_per_item == 1)
+                return nb::ndarray<nb::numpy, Scalar>(self.Data, {(size_t)self.Size}, owner);
+            else
+                return nb::ndarray<nb::numpy, Scalar>(self.Data, {(size_t)self.Size, nb_scalars_per_item}, owner);
+        },
+        nb::scope(cls), nb::name("numpy_view"), nb::is_method(),
+        "Zero-copy numpy view of the vector data (invalid once the vector is modified)");
+}
+
+// ImVector<ImDrawVert> is viewed as a structured array with fields pos (2 float32), uv (2 float32), col (uint32)
+void add_imvector_drawvert_numpy_view()
+{
+    nb::handle cls = nb::type<ImVector<ImDrawVert>>();
+    nb::cpp_function_def(
+        [](ImVector<ImDrawVert>& self) -> nb::object
+        {
+            nb::object owner = nb::cast(&self, nb::rv_policy::reference);
+            auto bytes = nb::ndarray<nb::numpy, uint8_t>(self.Data, {(size_t)self.Size * sizeof(ImDrawVert)}, owner);
+
+            nb::module_ np = nb::module_::import_("numpy");
+            nb::dict dtype_spec;
+            dtype_spec["names"] = nb::make_tuple("pos", "uv", "col");
+            dtype_spec["formats"] = nb::make_tuple("2<f4", "2<f4", "<u4");
+            dtype_spec["offsets"] = nb::make_tuple(offsetof(ImDrawVert, pos), offsetof(ImDrawVert, uv), offsetof(ImDrawVert, col));
+            dtype_spec["itemsize"] = sizeof(ImDrawVert);
+            nb::object dtype = np.attr("dtype")(dtype_spec);
+            return nb::cast(bytes).attr("view")(dtype);
+        },
+        nb::scope(cls), nb::name("numpy_view"), nb::is_method(),
+        "Zero-copy numpy view of the vertices, as a structured array with fields pos, uv, col\n"
+        "(invalid once the vector is modified)");
+}
+
+
 void imgui_manual_binding(nb::module_& m)
 {
     IM_ASSERT(pyClassImVec4Ptr != nullptr);
@@ -8329,6 +8375,16 @@ void imgui_manual_binding(nb::module_& m)
     //    return sizeof(cimgui.ImDrawIdx)
     m.attr("INDEX_SIZE") = sizeof(ImDrawIdx);
 
+    // numpy_view() methods for ImVector: e.g. draw_list.vtx_buffer.numpy_view(), draw_list.idx_buffer.numpy_view()
+    add_imvector_numpy_view<int, int>(1);
+    add_imvector_numpy_view<uint, uint>(1);
+    add_imvector_numpy_view<float, float>(1);
+    add_imvector_numpy_view<char, int8_t>(1);
+    add_imvector_numpy_view<uchar, uchar>(1);
+    add_imvector_numpy_view<ImVec2, float>(2);
+    add_imvector_numpy_view<ImVec4, float>(4);
+    add_imvector_drawvert_numpy_view();
+
 
     m.def("IM_COL32", [](int r, int g, int b, int a){
         return IM_COL32(r, g, b, a);
@@ -6,6 +6,12 @@
 #include "imgui_impl_opengl3.h"
 #include "imgui_impl_opengl2.h"
 
+#ifdef HELLOIMGUI_HAS_OPENGL
+#include "hello_imgui/hello_imgui_include_opengl.h"
+#endif
+
+#include <cstdint>
+
 namespace nb = nanobind;
 
 
@@ -15,8 +21,69 @@ struct GLFWcursor;
 
 // Note: all this code is generated *manually*
 
+
+#ifdef HELLOIMGUI_HAS_OPENGL
+// Uploads and draws the command lists of draw_data, using the given vertex array, vertex buffer and element buffer.
+// This is the inner loop of the pure python OpenGL backend (python_backends/opengl_backend.py),
+// which would otherwise issue several PyOpenGL calls per draw command.
+// The caller is responsible for setting up (and restoring) the GL state: program, uniforms, blending, viewport, etc.
+// Clip rects are expected to be in framebuffer coordinates (i.e. after ImDrawData::ScaleClipRects).
+static void OpenGL_SubmitDrawData(ImDrawData* draw_data, unsigned int vao_handle, unsigned int vbo_handle, unsigned int elements_handle, int fb_height)
+{
+#ifdef __glad_h_
+    // Python backends create their GL context without HelloImGui, so that glad may not be loaded yet
+    if (glad_glBufferData == nullptr)
+        gladLoadGL();
+#endif
+    const GLenum index_type = sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    glBindVertexArray(vao_handle);
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_handle);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elements_handle);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != nullptr)
+            {
+                // ImDrawCallback_ResetRenderState cannot be honored here: the state belongs to the python backend
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+
+            const ImVec4& clip_rect = pcmd->ClipRect;
+            if (clip_rect.z <= clip_rect.x || clip_rect.w <= clip_rect.y)
+                continue;
+
+            glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
+            glScissor((int)clip_rect.x, (int)(fb_height - clip_rect.w), (int)(clip_rect.z - clip_rect.x), (int)(clip_rect.w - clip_rect.y));
+            glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, index_type, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+        }
+    }
+}
+#endif // HELLOIMGUI_HAS_OPENGL
+
+
 void py_init_module_imgui_backends(nb::module_& m)
 {
+#ifdef HELLOIMGUI_HAS_OPENGL
+    //
+    // Native draw loop for the pure python OpenGL backend
+    //
+    m.def("opengl_submit_draw_data",
+        OpenGL_SubmitDrawData,
+        nb::arg("draw_data"), nb::arg("vao_handle"), nb::arg("vbo_handle"), nb::arg("elements_handle"), nb::arg("fb_height"),
+        "Uploads and draws the command lists of draw_data (used by the pure python OpenGL backend).\n"
+        "The GL state (program, uniforms, blending, viewport, etc.) must be set up by the caller.");
+#endif
+
     //
     // <bindings for imgui_impl_opengl3.h
     //
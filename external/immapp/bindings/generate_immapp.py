@@ -29,6 +29,8 @@ def main():
     options.srcmlcpp_options.header_filter_acceptable__regex += "|IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR|IMGUI_BUNDLE_WITH_IMPLOT_AND_IMGUI_NODE_EDITOR"
     options.srcmlcpp_options.ignored_warning_parts += ["unhandled tag endif", "unhandled tag ifdef"]
 
+    options.fn_exclude_by_name__regex = r"^CachedTweakedThemeStyle$"
+
     options.fn_return_force_policy_reference_for_references__regex = r".*"
     options.fn_return_force_policy_reference_for_pointers__regex = r".*"
 
@@ -39,6 +41,10 @@ def main():
     generator.process_cpp_file(CPP_HEADERS_DIR + "/clock.h")
     generator.process_cpp_file(CPP_HEADERS_DIR + "/code_utils.h")
     generator.process_cpp_file(CPP_HEADERS_DIR + "/snippets.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/logger.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/frame_pacing.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/theme_cache.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/settings_journal.h")
 
     generator.write_generated_code(
         output_cpp_pydef_file=output_cpp_pydef_file,
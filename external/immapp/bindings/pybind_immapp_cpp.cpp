@@ -7,11 +7,20 @@
 #include <nanobind/stl/function.h>
 #include <nanobind/ndarray.h>
 
+#include <cstring> // memcpy
+
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "immapp/immapp.h"
 #include "immapp/code_utils.h"
 #include "immapp/snippets.h"
+#include "immapp/logger.h"
+#include "immapp/software_renderer.h"
+#include "immapp/frame_pacing.h"
+#include "immapp/theme_cache.h"
+#include "immapp/settings_journal.h"
+#include "immapp/texture_readback.h"
 #include "immapp/immapp_widgets.h"
+#include "immapp/draw_data_stream.h"
 #ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
 #include "imgui-node-editor/imgui_node_editor_internal.h"
 
@@ -43,6 +52,43 @@ namespace nb = nanobind;
 #include <vector>
 
 
+// Returns RGBA pixels as a numpy array of shape (height, width, 4)
+nb::handle RgbaPixelsToNdarray(const std::vector<uint8_t>& pixels, int width, int height)
+{
+    size_t total_size = pixels.size();
+    uint8_t* ndarray_buffer = new uint8_t[total_size];
+    if (total_size > 0)
+        std::memcpy(ndarray_buffer, pixels.data(), total_size);
+
+    nb::capsule owner(ndarray_buffer, [](void* p) noexcept {
+        delete[] static_cast<uint8_t*>(p);
+    });
+
+    auto array = nb::ndarray<uint8_t>(
+        ndarray_buffer,
+        {(size_t)height, (size_t)width, (size_t)4},
+        owner,
+        {(int64_t)(4 * width), (int64_t)4, 1},
+        nb::dtype<uint8_t>(),
+        0,
+        0,
+        'C'
+    );
+
+    return nb::detail::ndarray_export(
+        array.handle(),
+        nb::numpy::value,
+        nb::rv_policy::move,
+        nullptr
+    );
+}
+
+nb::handle SoftwareImageToNdarray(const ImmApp::SoftwareImage& image)
+{
+    return RgbaPixelsToNdarray(image.pixels, image.width, image.height);
+}
+
+
 void py_init_module_immapp_cpp(nb::module_& m)
 {
     using namespace ImmApp;
@@ -57,6 +103,28 @@ void py_init_module_immapp_cpp(nb::module_& m)
     ////////////////////    <generated_from:immapp_widgets.h>    ////////////////////
     // #ifdef IMGUI_BUNDLE_WITH_IMPLOT_AND_IMGUI_NODE_EDITOR
     //
+    auto pyClassPlotInNodeEditorParams =
+        nb::class_<ImmApp::PlotInNodeEditorParams>
+            (m, "PlotInNodeEditorParams", " PlotInNodeEditorParams: tune how plots inside a node editor are culled\n (applies to BeginPlotInNodeEditor and ShowResizablePlotInNodeEditor)")
+        .def("__init__", [](ImmApp::PlotInNodeEditorParams * self, bool cullOffscreenPlots = true, float snapshotZoomThreshold = 0.5f, int maxSnapshots = 512)
+        {
+            new (self) ImmApp::PlotInNodeEditorParams();  // placement new
+            auto r = self;
+            r->cullOffscreenPlots = cullOffscreenPlots;
+            r->snapshotZoomThreshold = snapshotZoomThreshold;
+            r->maxSnapshots = maxSnapshots;
+        },
+        nb::arg("cull_offscreen_plots") = true, nb::arg("snapshot_zoom_threshold") = 0.5f, nb::arg("max_snapshots") = 512
+        )
+        .def_rw("cull_offscreen_plots", &ImmApp::PlotInNodeEditorParams::cullOffscreenPlots, " If True, plots that are outside the visible region of the node editor are not plotted:\n only their size is reserved")
+        .def_rw("snapshot_zoom_threshold", &ImmApp::PlotInNodeEditorParams::snapshotZoomThreshold, " When the node editor is zoomed out so that the plot is displayed at less than this scale\n (on screen pixels per canvas pixel), a cached snapshot of the plot is displayed instead\n of plotting it live. Set to 0 to always plot live.\n The snapshot is a low resolution image (rasterized at this scale), taken once,\n when the zoom goes below twice this scale.")
+        .def_rw("max_snapshots", &ImmApp::PlotInNodeEditorParams::maxSnapshots, "Maximum number of cached snapshots (the least recently displayed plots are discarded first)")
+        ;
+
+
+    m.def("get_plot_in_node_editor_params",
+        ImmApp::GetPlotInNodeEditorParams, nb::rv_policy::reference);
+
 
     m.def("begin_plot_in_node_editor",
         [](const char * title_id, const std::optional<const ImVec2> & size = std::nullopt, ImPlotFlags flags = 0) -> bool
@@ -125,7 +193,7 @@ void py_init_module_immapp_cpp(nb::module_& m)
     auto pyClassAddOnsParams =
         nb::class_<ImmApp::AddOnsParams>
             (m, "AddOnsParams", "///////////////////////////////////////////////////////////////////////////////////////\n\n AddOnParams: require specific ImGuiBundle packages (markdown, node editor, texture viewer)\n to be initialized at startup.\n\n/////////////////////////////////////////////////////////////////////////////////////")
-        .def("__init__", [](ImmApp::AddOnsParams * self, bool withImplot = false, bool withImplot3d = false, bool withMarkdown = false, bool withNodeEditor = false, bool withTexInspect = false, std::optional<NodeEditorConfig> withNodeEditorConfig = std::nullopt, bool updateNodeEditorColorsFromImguiColors = true, std::optional<ImGuiMd::MarkdownOptions> withMarkdownOptions = std::nullopt)
+        .def("__init__", [](ImmApp::AddOnsParams * self, bool withImplot = false, bool withImplot3d = false, bool withMarkdown = false, bool withNodeEditor = false, bool withTexInspect = false, std::optional<NodeEditorConfig> withNodeEditorConfig = std::nullopt, bool updateNodeEditorColorsFromImguiColors = true, std::optional<ImGuiMd::MarkdownOptions> withMarkdownOptions = std::nullopt, const std::optional<const std::vector<std::string>> & prefetchAssets = std::nullopt, bool buildFontAtlasInParallel = false, bool withAdaptiveIdling = false, float fpsIdleWithoutLease = 1.f, bool throttleUnchangedFrames = false, bool withJournaledSettings = false)
         {
             new (self) ImmApp::AddOnsParams();  // placement new
             auto r = self;
@@ -137,8 +205,17 @@ void py_init_module_immapp_cpp(nb::module_& m)
             r->withNodeEditorConfig = withNodeEditorConfig;
             r->updateNodeEditorColorsFromImguiColors = updateNodeEditorColorsFromImguiColors;
             r->withMarkdownOptions = withMarkdownOptions;
+            if (prefetchAssets.has_value())
+                r->prefetchAssets = prefetchAssets.value();
+            else
+                r->prefetchAssets = {};
+            r->buildFontAtlasInParallel = buildFontAtlasInParallel;
+            r->withAdaptiveIdling = withAdaptiveIdling;
+            r->fpsIdleWithoutLease = fpsIdleWithoutLease;
+            r->throttleUnchangedFrames = throttleUnchangedFrames;
+            r->withJournaledSettings = withJournaledSettings;
         },
-        nb::arg("with_implot") = false, nb::arg("with_implot3d") = false, nb::arg("with_markdown") = false, nb::arg("with_node_editor") = false, nb::arg("with_tex_inspect") = false, nb::arg("with_node_editor_config") = nb::none(), nb::arg("update_node_editor_colors_from_imgui_colors") = true, nb::arg("with_markdown_options") = nb::none()
+        nb::arg("with_implot") = false, nb::arg("with_implot3d") = false, nb::arg("with_markdown") = false, nb::arg("with_node_editor") = false, nb::arg("with_tex_inspect") = false, nb::arg("with_node_editor_config") = nb::none(), nb::arg("update_node_editor_colors_from_imgui_colors") = true, nb::arg("with_markdown_options") = nb::none(), nb::arg("prefetch_assets") = nb::none(), nb::arg("build_font_atlas_in_parallel") = false, nb::arg("with_adaptive_idling") = false, nb::arg("fps_idle_without_lease") = 1.f, nb::arg("throttle_unchanged_frames") = false, nb::arg("with_journaled_settings") = false
         )
         .def_rw("with_implot", &ImmApp::AddOnsParams::withImplot, "Set withImplot=True if you need to plot graphs with implot")
         .def_rw("with_implot3d", &ImmApp::AddOnsParams::withImplot3d, "Set withImplot3=True if you need to plot 3 graphs with implot3")
@@ -148,10 +225,16 @@ void py_init_module_immapp_cpp(nb::module_& m)
         // #ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
         //
         .def_rw("with_node_editor_config", &ImmApp::AddOnsParams::withNodeEditorConfig, "You can tweak NodeEditorConfig (but this is optional)")
-        .def_rw("update_node_editor_colors_from_imgui_colors", &ImmApp::AddOnsParams::updateNodeEditorColorsFromImguiColors, " If True, the node editor colors will be updated from the ImGui colors\n (i.e. if using a light theme, the node editor will use a light theme, etc.)\n This is called after runnerParams.callbacks.SetupImGuiStyle, in which you can set the ImGui style.\n If you set this to False, you can set the node editor style manually.\n (Note: you can also the theme via RunnerParams.imguiParams.tweakedTheme)")
+        .def_rw("update_node_editor_colors_from_imgui_colors", &ImmApp::AddOnsParams::updateNodeEditorColorsFromImguiColors, " If True, the node editor colors will be updated from the ImGui colors\n (i.e. if using a light theme, the node editor will use a light theme, etc.)\n This is called after runnerParams.callbacks.SetupImGuiStyle, in which you can set the ImGui style,\n and then again whenever the ImGui style colors change.\n If you set this to False, you can set the node editor style manually.\n (Note: you can also the theme via RunnerParams.imguiParams.tweakedTheme)")
         // #endif
         //
         .def_rw("with_markdown_options", &ImmApp::AddOnsParams::withMarkdownOptions, "You can tweak MarkdownOptions (but this is optional)")
+        .def_rw("prefetch_assets", &ImmApp::AddOnsParams::prefetchAssets, " Assets (fonts, images, ...) that will be loaded on worker threads while the window is being created.\n Use ImmApp::LoadAssetShared() to access them once loaded (HelloImGui's own loaders, such as LoadFont\n or ImageAndSizeFromAsset, read the files again).")
+        .def_rw("build_font_atlas_in_parallel", &ImmApp::AddOnsParams::buildFontAtlasInParallel, " Set buildFontAtlasInParallel=True to rasterize the fonts on several threads at startup\n (useful when many fonts are loaded, e.g. with markdown, on slow devices).\n See GetStartupTimings() to measure its effect.")
+        .def_rw("with_adaptive_idling", &ImmApp::AddOnsParams::withAdaptiveIdling, " Set withAdaptiveIdling=True to let ImmApp set runnerParams.fpsIdling.fpsIdle at each frame:\n it will be the lowest fps which satisfies all the animation leases (see AnimateUntil in frame_pacing.h),\n or fpsIdleWithoutLease when there are none. Use RequestRedraw() to display new data immediately.")
+        .def_rw("fps_idle_without_lease", &ImmApp::AddOnsParams::fpsIdleWithoutLease, "")
+        .def_rw("throttle_unchanged_frames", &ImmApp::AddOnsParams::throttleUnchangedFrames, " Set throttleUnchangedFrames=True to avoid rendering frames at full speed when their output does not change\n (see GetUnchangedFramesStats in frame_pacing.h)")
+        .def_rw("with_journaled_settings", &ImmApp::AddOnsParams::withJournaledSettings, " Set withJournaledSettings=True to store the settings incrementally in a journal (see settings_journal.h):\n the node editor settings are appended to it when they change (instead of rewriting .node_editor.json),\n and the ImGui settings are restored after a crash.")
         ;
 
 
@@ -239,6 +322,26 @@ void py_init_module_immapp_cpp(nb::module_& m)
         nb::arg("gui_function"), nb::arg("window_title") = "", nb::arg("window_size_auto") = false, nb::arg("window_restore_previous_geometry") = false, nb::arg("window_size") = nb::none(), nb::arg("fps_idle") = 10.f, nb::arg("with_implot") = false, nb::arg("with_implot3d") = false, nb::arg("with_node_editor") = false, nb::arg("with_tex_inspect") = false, nb::arg("with_node_editor_config") = nb::none(), nb::arg("with_markdown_options") = nb::none(),
         " Run an application with markdown\n\n\nPython bindings defaults:\n    If windowSize is None, then its default value will be: DefaultWindowSize");
 
+    auto pyClassStartupTimings =
+        nb::class_<ImmApp::StartupTimings>
+            (m, "StartupTimings", "")
+        .def("__init__", [](ImmApp::StartupTimings * self, double timeToFirstFrame = 0., double fontAtlasBuildDuration = 0.)
+        {
+            new (self) ImmApp::StartupTimings();  // placement new
+            auto r = self;
+            r->timeToFirstFrame = timeToFirstFrame;
+            r->fontAtlasBuildDuration = fontAtlasBuildDuration;
+        },
+        nb::arg("time_to_first_frame") = 0., nb::arg("font_atlas_build_duration") = 0.
+        )
+        .def_rw("time_to_first_frame", &ImmApp::StartupTimings::timeToFirstFrame, " Time between the application setup (ImmApp::Run or ManualRender::SetupFromXXX)\n and the end of the first frame, in seconds")
+        .def_rw("font_atlas_build_duration", &ImmApp::StartupTimings::fontAtlasBuildDuration, " Duration of the font atlas build, in seconds (only measured when AddOnsParams.buildFontAtlasInParallel\n is True: otherwise, the atlas is built by the renderer during the first frame)")
+        ;
+
+
+    m.def("get_startup_timings",
+        ImmApp::GetStartupTimings, "Returns the timings measured during the last application startup");
+
     m.def("em_size",
         nb::overload_cast<>(ImmApp::EmSize), " EmSize() returns the visible font size on the screen. For good results on HighDPI screens, always scale your\n widgets and windows relatively to this size.\n It is somewhat comparable to the [em CSS Unit](https://lyty.dev/css/css-unit.html).\n EmSize() = ImGui::GetFontSize()");
 
@@ -364,7 +467,54 @@ void py_init_module_immapp_cpp(nb::module_& m)
 
     ////////////////////    <generated_from:clock.h>    ////////////////////
     m.def("clock_seconds",
-        ImmApp::ClockSeconds, "Chronometer in seconds");
+        ImmApp::ClockSeconds, "Chronometer in seconds (monotonic)");
+
+    m.def("set_clock_uses_imgui_time",
+        ImmApp::SetClockUsesImGuiTime,
+        nb::arg("use_imgui_time"),
+        " If set to True, ClockSeconds() returns ImGui::GetTime(), i.e. a time that only advances by io.DeltaTime\n at each frame. Used by headless test runs with a fixed virtual time step (see RunTestsHeadless),\n so that animations do not depend on the machine speed.\n Must be called from the thread which runs ImGui: the other threads get the last ImGui time it read\n (the frame clock reads it before each frame).");
+
+
+    auto pyClassFrameClock =
+        nb::class_<ImmApp::FrameClock>
+            (m, "FrameClock", " FrameClock: the clock is sampled once per frame, so that all the widgets and animations\n of a frame share the same time stamp (instead of each sampling the OS clock).")
+        .def("__init__", [](ImmApp::FrameClock * self, double frameTime = 0., double deltaTime = 0., int frameIndex = 0)
+        {
+            new (self) ImmApp::FrameClock();  // placement new
+            auto r = self;
+            r->frameTime = frameTime;
+            r->deltaTime = deltaTime;
+            r->frameIndex = frameIndex;
+        },
+        nb::arg("frame_time") = 0., nb::arg("delta_time") = 0., nb::arg("frame_index") = 0
+        )
+        .def_rw("frame_time", &ImmApp::FrameClock::frameTime, "Time of the current frame, in seconds (same origin as ClockSeconds())")
+        .def_rw("delta_time", &ImmApp::FrameClock::deltaTime, "Time elapsed between the previous frame and the current frame, in seconds")
+        .def_rw("frame_index", &ImmApp::FrameClock::frameIndex, "Index of the current frame (0 for the first frame)")
+        ;
+
+
+    m.def("get_frame_clock",
+        ImmApp::GetFrameClock,
+        " Returns the clock of the current frame.\n ImmApp::Run samples it before each frame. Outside of ImmApp::Run, it is sampled on the first call\n of each ImGui frame (or on each call if there is no ImGui context): frameIndex then follows\n ImGui::GetFrameCount(), and deltaTime is the time elapsed since the previous call.",
+        nb::rv_policy::reference);
+
+
+    auto pyClassFixedTimestepAccumulator =
+        nb::class_<ImmApp::FixedTimestepAccumulator>
+            (m, "FixedTimestepAccumulator", " FixedTimestepAccumulator: helps to advance an animation or a simulation by fixed steps,\n independently of the frame rate. Usage:\n     static ImmApp::FixedTimestepAccumulator accumulator(1. / 60.);\n     int nbSteps = accumulator.Advance();\n     for (int i = 0; i < nbSteps; ++i)\n         MySimulationStep(accumulator.step);")
+        .def_rw("step", &ImmApp::FixedTimestepAccumulator::step, "Duration of a step, in seconds")
+        .def_rw("max_steps_per_advance", &ImmApp::FixedTimestepAccumulator::maxStepsPerAdvance, "Maximum number of steps returned by Advance (avoids a spiral of death after a long hitch)")
+        .def_rw("accumulated_time", &ImmApp::FixedTimestepAccumulator::accumulatedTime, "Time accumulated, which was not yet consumed by steps")
+        .def(nb::init<double>(),
+            nb::arg("step_") = 1. / 60.)
+        .def("advance",
+            &ImmApp::FixedTimestepAccumulator::Advance,
+            nb::arg("delta_time") = -1.,
+            " Accumulates deltaTime (or the frame clock deltaTime, if deltaTime < 0),\n and returns the number of steps to perform")
+        .def("alpha",
+            &ImmApp::FixedTimestepAccumulator::Alpha, "Position between the last step and the next one, in [0, 1[ (useful to interpolate the display)")
+        ;
     ////////////////////    </generated_from:clock.h>    ////////////////////
 
 
@@ -463,6 +613,313 @@ void py_init_module_immapp_cpp(nb::module_& m)
     } // </namespace Snippets>
     ////////////////////    </generated_from:snippets.h>    ////////////////////
 
+
+    ////////////////////    <generated_from:logger.h>    ////////////////////
+    auto pyClassLogParams =
+        nb::class_<ImmApp::LogParams>
+            (m, "LogParams", " ImmApp::Log is an alternative to HelloImGui::Log, for applications which log a lot, from several threads:\n - Log() can be called from any thread. It is wait-free and does not allocate: messages are formatted\n   into a preallocated ring buffer (and truncated to LogParams::maxMessageLength).\n - Only the last LogParams::capacity messages are retained: older messages are overwritten.\n - LogGui() only renders the visible lines, with level filters and a search field:\n   its cost per frame does not depend on the number of retained messages.\n   LogGui() must be called from the main thread.")
+        .def("__init__", [](ImmApp::LogParams * self, int capacity = 65536, int maxMessageLength = 256)
+        {
+            new (self) ImmApp::LogParams();  // placement new
+            auto r = self;
+            r->capacity = capacity;
+            r->maxMessageLength = maxMessageLength;
+        },
+        nb::arg("capacity") = 65536, nb::arg("max_message_length") = 256
+        )
+        .def_rw("capacity", &ImmApp::LogParams::capacity, "Number of retained messages (rounded up to a power of two)")
+        .def_rw("max_message_length", &ImmApp::LogParams::maxMessageLength, "Maximum length of a message, in bytes (longer messages are truncated)")
+        ;
+
+
+    m.def("set_log_params",
+        ImmApp::SetLogParams,
+        nb::arg("params"),
+        "SetLogParams must be called before the first call to Log (the ring buffer is allocated on first use)");
+
+    m.def("log",
+        [](HelloImGui::LogLevel level, const char * const format)
+        {
+            auto Log_adapt_variadic_format = [](HelloImGui::LogLevel level, const char * const format)
+            {
+                ImmApp::Log(level, "%s", format);
+            };
+
+            Log_adapt_variadic_format(level, format);
+        },     nb::arg("level"), nb::arg("format"));
+
+    m.def("log_clear",
+        ImmApp::LogClear);
+
+    m.def("log_gui",
+        [](const std::optional<const ImVec2> & size = std::nullopt)
+        {
+            auto LogGui_adapt_mutable_param_with_default_value = [](const std::optional<const ImVec2> & size = std::nullopt)
+            {
+
+                const ImVec2& size_or_default = [&]() -> const ImVec2 {
+                    if (size.has_value())
+                        return size.value();
+                    else
+                        return ImVec2(0.f, 0.f);
+                }();
+
+                ImmApp::LogGui(size_or_default);
+            };
+
+            LogGui_adapt_mutable_param_with_default_value(size);
+        },
+        nb::arg("size") = nb::none(),
+        "Python bindings defaults:\n    If size is None, then its default value will be: ImVec2(0., 0.)");
+    ////////////////////    </generated_from:logger.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:frame_pacing.h>    ////////////////////
+    m.def("request_redraw",
+        ImmApp::RequestRedraw, "Wakes up the main loop, so that a new frame is rendered (thread-safe)");
+
+    m.def("animate_until",
+        ImmApp::AnimateUntil,
+        nb::arg("lease_id"), nb::arg("until_time"), nb::arg("fps") = 0.f,
+        " Requests frames at least at `fps` (0: maximum refresh speed) until ClockSeconds() reaches untilTime.\n Calling it again with the same leaseId replaces the lease (thread-safe)");
+
+    m.def("animate_for",
+        ImmApp::AnimateFor,
+        nb::arg("lease_id"), nb::arg("duration"), nb::arg("fps") = 0.f,
+        "Same as AnimateUntil(leaseId, ClockSeconds() + duration, fps)");
+
+    m.def("end_animation",
+        ImmApp::EndAnimation,
+        nb::arg("lease_id"),
+        "Ends a lease before its end time");
+
+    m.def("required_animation_fps",
+        ImmApp::RequiredAnimationFps, "The fps required by the active leases (-1 if there are none, 0 for the maximum refresh speed)");
+
+
+    auto pyClassUnchangedFramesStats =
+        nb::class_<ImmApp::UnchangedFramesStats>
+            (m, "UnchangedFramesStats", " Unchanged frames: many frames produce the same draw data as the previous frame (cursor parked,\n nothing animating). When AddOnsParams::throttleUnchangedFrames is True, ImmApp hashes the draw data\n of each frame, and counts those frames: after an unchanged frame, the main loop waits for an event\n (user input, RequestRedraw(), ...) during at most 1 / fpsIdle seconds (or 1 / RequiredAnimationFps()),\n instead of rendering the next frame immediately. Otherwise, the stats stay at zero.")
+        .def("__init__", [](ImmApp::UnchangedFramesStats * self, int nbFrames = 0, int nbUnchangedFrames = 0, int nbThrottledFrames = 0)
+        {
+            new (self) ImmApp::UnchangedFramesStats();  // placement new
+            auto r = self;
+            r->nbFrames = nbFrames;
+            r->nbUnchangedFrames = nbUnchangedFrames;
+            r->nbThrottledFrames = nbThrottledFrames;
+        },
+        nb::arg("nb_frames") = 0, nb::arg("nb_unchanged_frames") = 0, nb::arg("nb_throttled_frames") = 0
+        )
+        .def_rw("nb_frames", &ImmApp::UnchangedFramesStats::nbFrames, "Number of rendered frames")
+        .def_rw("nb_unchanged_frames", &ImmApp::UnchangedFramesStats::nbUnchangedFrames, "Number of frames whose draw data was identical to the previous frame's")
+        .def_rw("nb_throttled_frames", &ImmApp::UnchangedFramesStats::nbThrottledFrames, "Number of unchanged frames after which the main loop waited for an event")
+        ;
+
+
+    m.def("get_unchanged_frames_stats",
+        ImmApp::GetUnchangedFramesStats);
+
+    m.def("hash_draw_data",
+        ImmApp::HashDrawData,
+        nb::arg("draw_data"),
+        "Hash of the draw data (vertices, indices, commands and display rect)");
+    ////////////////////    </generated_from:frame_pacing.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:theme_cache.h>    ////////////////////
+    m.def("push_cached_tweaked_theme",
+        ImmApp::PushCachedTweakedTheme,
+        nb::arg("tweaked_theme"),
+        "Same as ImGuiTheme::PushTweakedTheme() / PopTweakedTheme(), with cached styles");
+
+    m.def("pop_cached_tweaked_theme",
+        ImmApp::PopCachedTweakedTheme);
+
+    m.def("clear_theme_cache",
+        ImmApp::ClearThemeCache);
+    ////////////////////    </generated_from:theme_cache.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:settings_journal.h>    ////////////////////
+    auto pyClassSettingsJournal =
+        nb::class_<ImmApp::SettingsJournal>
+            (m, "SettingsJournal", " SettingsJournal: a persistent key/value store for settings, which is written incrementally.\n - Set() appends the changed key to the journal file (unchanged values are not written),\n   so that the settings survive a crash, and nothing remains to be written at exit.\n - The file is read lazily, on the first access.\n - When the journal grows much larger than the live settings, it is compacted on a background thread.\n   Compaction never delays the exit: it is cancelled if the journal is closed in the meantime.\n All the methods are thread-safe.\n\n Each record is flushed to the OS when written: the settings survive an app crash\n (but not necessarily a power loss). A record torn by a crash is ignored when loading.")
+        .def(nb::init<const std::string &>(),
+            nb::arg("filename"))
+        .def("get",
+            &ImmApp::SettingsJournal::Get, nb::arg("key"))
+        .def("has",
+            &ImmApp::SettingsJournal::Has, nb::arg("key"))
+        .def("set",
+            &ImmApp::SettingsJournal::Set, nb::arg("key"), nb::arg("value"))
+        .def("erase",
+            &ImmApp::SettingsJournal::Erase, nb::arg("key"))
+        .def("compact",
+            &ImmApp::SettingsJournal::Compact, "Rewrites the journal with only the live settings (synchronously)")
+        .def("filename",
+            &ImmApp::SettingsJournal::Filename, nb::rv_policy::reference)
+        ;
+
+
+    m.def("get_settings_journal",
+        ImmApp::GetSettingsJournal,
+        "Returns the settings journal of the running app (None if AddOnsParams::withJournaledSettings is False)",
+        nb::rv_policy::reference);
+
+    m.def("settings_journal_location",
+        ImmApp::SettingsJournalLocation,
+        nb::arg("runner_params"),
+        " SettingsJournalLocation returns the path to the settings journal:\n path/to/your/app.ini => path/to/your/app.settings_journal");
+
+    m.def("save_user_pref_to_journal",
+        ImmApp::SaveUserPrefToJournal,
+        nb::arg("user_pref_name"), nb::arg("user_pref_content"),
+        " SaveUserPrefToJournal / LoadUserPrefFromJournal: same as HelloImGui::SaveUserPref / LoadUserPref,\n but the preference is written to the settings journal as soon as it is saved (not only at exit).\n If the journal is disabled, they call HelloImGui::SaveUserPref / LoadUserPref.\n LoadUserPrefFromJournal falls back to the preferences saved by HelloImGui::SaveUserPref.");
+
+    m.def("load_user_pref_from_journal",
+        ImmApp::LoadUserPrefFromJournal, nb::arg("user_pref_name"));
+    ////////////////////    </generated_from:settings_journal.h>    ////////////////////
+
     // </litgen_pydef> // Autogenerated code end
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!  AUTOGENERATED CODE END !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+    // Software renderer (manual bindings: the images are returned as numpy arrays)
+    m.def("software_render_draw_data",
+        [](ImDrawData* draw_data, int nb_threads, const ImVec4& clear_color) {
+            ImmApp::SoftwareRendererParams params;
+            params.nbThreads = nb_threads;
+            params.clearColor = clear_color;
+            ImmApp::SoftwareImage image;
+            {
+                nb::gil_scoped_release release;
+                ImmApp::SoftwareRenderDrawData(draw_data, &image, params);
+            }
+            return SoftwareImageToNdarray(image);
+        },
+        nb::arg("draw_data"), nb::arg("nb_threads") = 0, nb::arg("clear_color") = ImVec4(0.f, 0.f, 0.f, 1.f),
+        "Renders draw_data on the CPU, and returns an RGBA image (numpy array of shape (height, width, 4))");
+    m.def("final_app_window_software_screenshot",
+        []() { return SoftwareImageToNdarray(ImmApp::FinalAppWindowSoftwareScreenshot()); },
+        "When the renderer backend is Null, returns the last frame of the last (exited) app, rendered on the CPU (RGBA)");
+
+    // Asynchronous readback (manual bindings: the images are returned as numpy arrays)
+    nb::class_<ImmApp::AsyncReadback>(m, "AsyncReadback",
+            "Asynchronous readback of textures (OpenGL renderer only): the pixels are received one or two frames\n"
+            "after the request, without stalling the GPU. Read only the region you need.")
+        .def(nb::init<int>(), nb::arg("nb_buffers") = 3)
+        .def("request_texture_region", &ImmApp::AsyncReadback::RequestTextureRegion,
+            nb::arg("texture"), nb::arg("x"), nb::arg("y"), nb::arg("width"), nb::arg("height"),
+            "Queues a copy of a region of an RGBA texture.\n"
+            "Returns False if all the buffers are in flight (call poll() at each frame to receive them)")
+        .def("poll", &ImmApp::AsyncReadback::Poll,
+            "Receives the requests which the GPU has finished, without waiting.\n"
+            "Returns True if latest_image() was updated")
+        .def("latest_image",
+            [](const ImmApp::AsyncReadback& self) {
+                const ImmApp::ReadbackImage& image = self.LatestImage();
+                return RgbaPixelsToNdarray(image.pixels, image.width, image.height);
+            },
+            "The last received region (RGBA numpy array of shape (height, width, 4))")
+        .def("nb_pending_requests", &ImmApp::AsyncReadback::NbPendingRequests)
+        .def("release", &ImmApp::AsyncReadback::Release,
+            "Deletes the OpenGL objects (call it before the OpenGL context is destroyed)")
+        ;
+    m.def("request_app_window_screenshot",
+        ImmApp::RequestAppWindowScreenshot,
+        "Requests an asynchronous screenshot of the app window (OpenGL renderer only): see poll_app_window_screenshot()");
+    m.def("poll_app_window_screenshot",
+        []() -> nb::object {
+            ImmApp::ReadbackImage screenshot;
+            if (!ImmApp::PollAppWindowScreenshot(&screenshot))
+                return nb::none();
+            return nb::steal(RgbaPixelsToNdarray(screenshot.pixels, screenshot.width, screenshot.height));
+        },
+        "Returns the requested screenshot once it was received (RGBA numpy array of shape (height, width, 4)), or None");
+
+    // Draw data streaming (manual bindings: the packets are bytes)
+    nb::class_<ImmApp::DrawDataStreamParams>(m, "DrawDataStreamParams")
+        .def(nb::init<>())
+        .def_rw("position_subdivisions", &ImmApp::DrawDataStreamParams::positionSubdivisions,
+            "Positions and clip rects are rounded to 1 / position_subdivisions pixels")
+        .def_rw("min_frame_interval", &ImmApp::DrawDataStreamParams::minFrameInterval,
+            "The frame rate will not exceed 1 / min_frame_interval")
+        .def_rw("initial_bandwidth", &ImmApp::DrawDataStreamParams::initialBandwidth,
+            "Initial bandwidth estimation (bytes per second), before the first packet is delivered")
+        ;
+    nb::class_<ImmApp::DrawDataStreamEncoder>(m, "DrawDataStreamEncoder",
+            "Encodes ImDrawData into compact packets, for remoting over slow links (see DrawDataStreamDecoder)")
+        .def(nb::init<const ImmApp::DrawDataStreamParams&>(), nb::arg("params") = ImmApp::DrawDataStreamParams())
+        .def("encode_frame",
+            [](ImmApp::DrawDataStreamEncoder& self, const ImDrawData* draw_data, double now) {
+                std::vector<uint8_t> packet;
+                self.EncodeFrame(draw_data, &packet, now);
+                return nb::bytes(reinterpret_cast<const char*>(packet.data()), packet.size());
+            },
+            nb::arg("draw_data"), nb::arg("now") = -1.,
+            "Encodes a frame into a packet (now: send time, default clock_seconds())")
+        .def("request_key_frame", &ImmApp::DrawDataStreamEncoder::RequestKeyFrame,
+            "The next packet will not refer to the previous frame (e.g. when a new client connects)")
+        .def("shall_send_frame", &ImmApp::DrawDataStreamEncoder::ShallSendFrame, nb::arg("now"),
+            "Adaptive frame rate: returns True if a frame shall be sent now")
+        .def("on_packet_delivered", &ImmApp::DrawDataStreamEncoder::OnPacketDelivered,
+            nb::arg("packet_size"), nb::arg("transfer_duration"),
+            "Shall be called by the transport when a packet was delivered (transfer_duration does not include the latency)")
+        .def("estimated_bandwidth", &ImmApp::DrawDataStreamEncoder::EstimatedBandwidth)
+        ;
+    nb::class_<ImmApp::DecodedDrawCmd>(m, "DecodedDrawCmd")
+        .def_ro("clip_rect", &ImmApp::DecodedDrawCmd::ClipRect)
+        .def_ro("texture_id", &ImmApp::DecodedDrawCmd::TextureId)
+        .def_ro("vtx_offset", &ImmApp::DecodedDrawCmd::VtxOffset)
+        .def_ro("idx_offset", &ImmApp::DecodedDrawCmd::IdxOffset)
+        .def_ro("elem_count", &ImmApp::DecodedDrawCmd::ElemCount)
+        ;
+    nb::class_<ImmApp::DecodedDrawList>(m, "DecodedDrawList")
+        .def_ro("vtx_buffer", &ImmApp::DecodedDrawList::VtxBuffer)
+        .def_ro("idx_buffer", &ImmApp::DecodedDrawList::IdxBuffer)
+        .def_ro("cmd_buffer", &ImmApp::DecodedDrawList::CmdBuffer)
+        ;
+    nb::class_<ImmApp::DrawDataStreamDecoder>(m, "DrawDataStreamDecoder",
+            "The client side: decodes the packets of a DrawDataStreamEncoder")
+        .def(nb::init<>())
+        .def("decode_frame",
+            [](ImmApp::DrawDataStreamDecoder& self, const nb::bytes& packet) {
+                return self.DecodeFrame(reinterpret_cast<const uint8_t*>(packet.c_str()), packet.size());
+            },
+            nb::arg("packet"),
+            "Returns False if the packet is invalid (including commands which refer to vertices or indices\n"
+            "out of their list), or refers to a list which could not be decoded")
+        .def_ro("display_pos", &ImmApp::DrawDataStreamDecoder::displayPos)
+        .def_ro("display_size", &ImmApp::DrawDataStreamDecoder::displaySize)
+        .def_ro("framebuffer_scale", &ImmApp::DrawDataStreamDecoder::framebufferScale)
+        .def_ro("draw_lists", &ImmApp::DrawDataStreamDecoder::drawLists)
+        .def_ro("frame_index", &ImmApp::DrawDataStreamDecoder::frameIndex)
+        ;
+    nb::class_<ImmApp::RemotingLinkParams>(m, "RemotingLinkParams")
+        .def(nb::init<>())
+        .def_rw("bandwidth", &ImmApp::RemotingLinkParams::bandwidth, "Bytes per second")
+        .def_rw("latency", &ImmApp::RemotingLinkParams::latency, "One way latency, in seconds")
+        ;
+    nb::class_<ImmApp::RemotingLoopbackStats>(m, "RemotingLoopbackStats")
+        .def_ro("nb_frames_rendered", &ImmApp::RemotingLoopbackStats::nbFramesRendered)
+        .def_ro("nb_frames_sent", &ImmApp::RemotingLoopbackStats::nbFramesSent)
+        .def_ro("nb_frames_decoded", &ImmApp::RemotingLoopbackStats::nbFramesDecoded)
+        .def_ro("bytes_sent", &ImmApp::RemotingLoopbackStats::bytesSent)
+        .def_ro("raw_bytes", &ImmApp::RemotingLoopbackStats::rawBytes)
+        .def_ro("average_latency", &ImmApp::RemotingLoopbackStats::averageLatency)
+        .def_ro("last_latency", &ImmApp::RemotingLoopbackStats::lastLatency)
+        .def_ro("encode_duration", &ImmApp::RemotingLoopbackStats::encodeDuration)
+        .def_ro("decode_duration", &ImmApp::RemotingLoopbackStats::decodeDuration)
+        ;
+    nb::class_<ImmApp::RemotingLoopback>(m, "RemotingLoopback",
+            "A local stand-in for a remote client: the frames are encoded, sent through a simulated link,\n"
+            "and decoded, so that the throughput and the latency can be measured on one machine.\n"
+            "Usage: runner_params.callbacks.after_swap = lambda: loopback.on_frame_rendered(imgui.get_draw_data())")
+        .def(nb::init<const ImmApp::RemotingLinkParams&, const ImmApp::DrawDataStreamParams&>(),
+            nb::arg("link_params") = ImmApp::RemotingLinkParams(), nb::arg("stream_params") = ImmApp::DrawDataStreamParams())
+        .def("on_frame_rendered", &ImmApp::RemotingLoopback::OnFrameRendered,
+            nb::arg("draw_data"), nb::arg("now") = -1.,
+            "Call this after each frame (e.g. in runner_params.callbacks.after_swap)")
+        .def("stats", &ImmApp::RemotingLoopback::Stats, nb::rv_policy::reference_internal)
+        .def("client", &ImmApp::RemotingLoopback::Client, nb::rv_policy::reference_internal)
+        ;
 }
@@ -0,0 +1,238 @@
+#include "immapp/asset_cache.h"
+#include "hello_imgui/hello_imgui.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__) && !defined(__ANDROID__)
+#define IMMAPP_ASSET_CACHE_CAN_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        using AssetFuture = std::shared_future<SharedAssetBuffer>;
+
+        AssetCacheParams gAssetCacheParams;
+
+        std::mutex gAssetCacheMutex;
+        std::unordered_map<std::string, AssetFuture> gAssetCache;
+
+        // Asynchronous loads are queued, and run by a few worker threads (which exit when the queue is empty)
+        struct AssetLoadJob
+        {
+            std::string assetPath;
+            std::promise<SharedAssetBuffer> promise;
+        };
+        std::deque<AssetLoadJob> gAssetLoadJobs;  // protected by gAssetCacheMutex
+        int gNbAssetWorkers = 0;                  // protected by gAssetCacheMutex
+
+
+#ifdef IMMAPP_ASSET_CACHE_CAN_MMAP
+        // Returns nullptr if the file is too small to be worth mapping, or if it cannot be mapped
+        SharedAssetBuffer MemoryMapAsset(const std::string& assetPath, size_t thresholdBytes)
+        {
+            std::string fullPath = HelloImGui::AssetFileFullPath(assetPath, false);
+            int fd = open(fullPath.c_str(), O_RDONLY);
+            if (fd < 0)
+                return nullptr;
+            struct stat fileStat;
+            if (fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < thresholdBytes || fileStat.st_size == 0)
+            {
+                close(fd);
+                return nullptr;
+            }
+            size_t fileSize = (size_t)fileStat.st_size;
+            void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd); // the mapping stays valid after the file is closed
+            if (mapped == MAP_FAILED)
+                return nullptr;
+
+            auto buffer = new AssetBuffer{mapped, fileSize, true};
+            return SharedAssetBuffer(buffer, [](const AssetBuffer* b) {
+                munmap(const_cast<void*>(b->data), b->dataSize);
+                delete b;
+            });
+        }
+#endif
+
+        SharedAssetBuffer LoadAssetUncached(const std::string& assetPath)
+        {
+            if (!HelloImGui::AssetExists(assetPath))
+                throw std::runtime_error("ImmApp::LoadAssetShared: cannot find asset " + assetPath);
+
+#ifdef IMMAPP_ASSET_CACHE_CAN_MMAP
+            if (auto mapped = MemoryMapAsset(assetPath, gAssetCacheParams.memoryMapThresholdBytes))
+                return mapped;
+#endif
+
+            HelloImGui::AssetFileData fileData = HelloImGui::LoadAssetFileData(assetPath.c_str());
+            if (fileData.data == nullptr)
+                throw std::runtime_error("ImmApp::LoadAssetShared: cannot load asset " + assetPath);
+
+            auto buffer = new AssetBuffer{fileData.data, fileData.dataSize, false};
+            return SharedAssetBuffer(buffer, [fileData](const AssetBuffer* b) mutable {
+                HelloImGui::FreeAssetFileData(&fileData);
+                delete b;
+            });
+        }
+
+        int MaxAssetWorkers()
+        {
+            // Loading is mostly I/O bound: a few threads are enough, even with many cores
+            return (int)std::clamp(std::thread::hardware_concurrency(), 1u, 4u);
+        }
+
+        void AssetWorkerLoop()
+        {
+            while (true)
+            {
+                AssetLoadJob job;
+                {
+                    std::lock_guard<std::mutex> lock(gAssetCacheMutex);
+                    if (gAssetLoadJobs.empty())
+                    {
+                        --gNbAssetWorkers;
+                        return;
+                    }
+                    job = std::move(gAssetLoadJobs.front());
+                    gAssetLoadJobs.pop_front();
+                }
+                try
+                {
+                    job.promise.set_value(LoadAssetUncached(job.assetPath));
+                }
+                catch (...)
+                {
+                    job.promise.set_exception(std::current_exception());
+                }
+            }
+        }
+
+        bool IsReady(const AssetFuture& future)
+        {
+            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        bool HasFailed(const AssetFuture& future)
+        {
+            if (!IsReady(future))
+                return false;
+            try
+            {
+                future.get();
+                return false;
+            }
+            catch (...)
+            {
+                return true;
+            }
+        }
+
+        // Returns the cached future for this asset, if any (failed loads are forgotten, so that they can be retried).
+        // Must be called with gAssetCacheMutex locked.
+        bool FindCachedAsset(const std::string& assetPath, AssetFuture* outFuture)
+        {
+            auto it = gAssetCache.find(assetPath);
+            if (it == gAssetCache.end())
+                return false;
+            if (HasFailed(it->second))
+            {
+                gAssetCache.erase(it);
+                return false;
+            }
+            *outFuture = it->second;
+            return true;
+        }
+    } // anonymous namespace
+
+
+    AssetCacheParams& GetAssetCacheParams()
+    {
+        return gAssetCacheParams;
+    }
+
+    SharedAssetBuffer LoadAssetShared(const std::string& assetPath)
+    {
+        AssetFuture future;
+        std::promise<SharedAssetBuffer> promise;
+        bool isCached;
+        {
+            std::lock_guard<std::mutex> lock(gAssetCacheMutex);
+            isCached = FindCachedAsset(assetPath, &future);
+            if (!isCached)
+            {
+                future = promise.get_future().share();
+                gAssetCache[assetPath] = future;
+            }
+        }
+        if (isCached)
+            return future.get(); // may wait for a pending async load (without holding the lock)
+
+        // Load on the calling thread
+        try
+        {
+            promise.set_value(LoadAssetUncached(assetPath));
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+        }
+        return future.get();
+    }
+
+    std::shared_future<SharedAssetBuffer> LoadAssetAsync(const std::string& assetPath)
+    {
+        std::lock_guard<std::mutex> lock(gAssetCacheMutex);
+        AssetFuture future;
+        if (FindCachedAsset(assetPath, &future))
+            return future;
+
+#ifdef __EMSCRIPTEN__
+        future = std::async(std::launch::deferred, LoadAssetUncached, assetPath).share();
+#else
+        AssetLoadJob job;
+        job.assetPath = assetPath;
+        future = job.promise.get_future().share();
+        gAssetLoadJobs.push_back(std::move(job));
+        if (gNbAssetWorkers < MaxAssetWorkers())
+        {
+            ++gNbAssetWorkers;
+            std::thread(AssetWorkerLoop).detach();
+        }
+#endif
+        gAssetCache[assetPath] = future;
+        return future;
+    }
+
+    void PrefetchAssets(const std::vector<std::string>& assetPaths)
+    {
+        for (const auto& assetPath : assetPaths)
+            LoadAssetAsync(assetPath);
+    }
+
+    void TrimAssetCache()
+    {
+        std::lock_guard<std::mutex> lock(gAssetCacheMutex);
+        for (auto it = gAssetCache.begin(); it != gAssetCache.end(); )
+        {
+            // Pending loads are kept (their workers will fulfill them)
+            bool canErase = IsReady(it->second) && (HasFailed(it->second) || it->second.get().use_count() == 1);
+            if (canErase)
+                it = gAssetCache.erase(it);
+            else
+                ++it;
+        }
+    }
+} // namespace ImmApp
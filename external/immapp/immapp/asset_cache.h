@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace ImmApp
+{
+    // AssetBuffer: the content of an asset file, shared between all the users of the asset cache.
+    // The memory is released when the last SharedAssetBuffer referencing it is destroyed
+    // (and the asset was removed from the cache, see TrimAssetCache).
+    struct AssetBuffer
+    {
+        const void* data = nullptr;
+        size_t dataSize = 0;
+        // True if the file is memory-mapped (large files, on Linux and macOS)
+        bool isMemoryMapped = false;
+    };
+    using SharedAssetBuffer = std::shared_ptr<const AssetBuffer>;
+
+
+    struct AssetCacheParams
+    {
+        // Files larger than this (in bytes) are memory-mapped instead of being read, when the platform allows it
+        size_t memoryMapThresholdBytes = 1024 * 1024;
+    };
+    AssetCacheParams& GetAssetCacheParams();
+
+
+    // LoadAssetShared: returns the content of an asset, which is loaded only once and then kept in a cache.
+    // Uses HelloImGui::LoadAssetFileData, so that it works on all platforms (including android).
+    // Throws std::runtime_error if the asset cannot be loaded.
+    SharedAssetBuffer LoadAssetShared(const std::string& assetPath);
+
+    // LoadAssetAsync: queues the loading of an asset on a small pool of worker threads (at most 4),
+    // and returns a future to its content (if the asset is already cached or being loaded, the same future is returned).
+    // Note: under emscripten, the loading is deferred until the future is waited for.
+    std::shared_future<SharedAssetBuffer> LoadAssetAsync(const std::string& assetPath);
+
+    // PrefetchAssets: starts loading several assets on worker threads (e.g. fonts and images at startup).
+    // Assets that fail to load are simply not cached (LoadAssetShared will then report the error).
+    // Only the callers of LoadAssetShared / LoadAssetAsync benefit from it: HelloImGui's own loaders
+    // (LoadFont, ImageAndSizeFromAsset, ..., which also load the markdown fonts) read the files again.
+    void PrefetchAssets(const std::vector<std::string>& assetPaths);
+
+    // TrimAssetCache: removes the assets that are not referenced outside the cache anymore.
+    void TrimAssetCache();
+} // namespace ImmApp
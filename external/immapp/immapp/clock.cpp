@@ -1,32 +1,137 @@
 #include "immapp/immapp.h"
+#include "imgui.h"
+#include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/internal/functional_utils.h"
+#include <atomic>
 #include <chrono>
+#include <thread>
 
 
 namespace ImmApp
 {
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point gClockStart = Clock::now();
+        std::atomic<bool> gClockUsesImGuiTime { false };
+        // ImGui::GetTime() is only read by the thread which called SetClockUsesImGuiTime (the ImGui thread):
+        // the other threads (e.g. ImmApp::Log producers) get the last time it read
+        std::thread::id gImGuiTimeThread;
+        std::atomic<double> gImGuiTimeSnapshot { 0. };
+
+        FrameClock gFrameClock;
+        bool gFrameClockStarted = false;
+        // ImGui::GetFrameCount() of the frame which was sampled
+        int gFrameClockImGuiFrame = -1;
+        // Set while ImmApp::Run samples the clock before each frame
+        bool gFrameClockSampledByRunner = false;
+        // Outside of ImmApp::Run: ImGui::GetFrameCount() of the first frame which was sampled
+        int gFrameClockFirstImGuiFrame = -1;
+    }
 
-    class ClockSeconds_
+    void SetClockUsesImGuiTime(bool useImGuiTime)
     {
-        // Typical C++ shamanic incantations to get a time in seconds
-    private:
-        using Clock = std::chrono::high_resolution_clock;
-        using second = std::chrono::duration<double, std::ratio<1>>;
-        std::chrono::time_point<Clock> mStart;
+        gImGuiTimeThread = std::this_thread::get_id();
+        gImGuiTimeSnapshot = ImGui::GetCurrentContext() != nullptr ? ImGui::GetTime() : 0.;
+        gClockUsesImGuiTime = useImGuiTime;
+    }
 
-    public:
-        ClockSeconds_() : mStart(Clock::now()) {}
+    double ClockSeconds()
+    {
+        if (gClockUsesImGuiTime)
+        {
+            if (std::this_thread::get_id() == gImGuiTimeThread && ImGui::GetCurrentContext() != nullptr)
+                gImGuiTimeSnapshot = ImGui::GetTime();
+            return gImGuiTimeSnapshot;
+        }
+        return std::chrono::duration<double>(Clock::now() - gClockStart).count();
+    }
 
-        double elapsed() const
+    // Called by the runner before each frame
+    static void Priv_SampleFrameClock()
+    {
+        double now = ClockSeconds();
+        if (gFrameClockStarted)
         {
-            return std::chrono::duration_cast<second>
-                (Clock::now() - mStart).count();
+            gFrameClock.deltaTime = now - gFrameClock.frameTime;
+            ++gFrameClock.frameIndex;
         }
-    };
+        gFrameClock.frameTime = now;
+        gFrameClockStarted = true;
+    }
 
-    double ClockSeconds()
+    void Priv_SetupFrameClock(HelloImGui::RunnerParams& runnerParams)
+    {
+        gFrameClock = FrameClock();
+        gFrameClockStarted = false;
+        gFrameClockSampledByRunner = true;
+        // First, so that the other callbacks see the clock of the new frame
+        runnerParams.callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+            Priv_SampleFrameClock,
+            runnerParams.callbacks.PreNewFrame);
+    }
+
+    void Priv_TearDownFrameClock()
+    {
+        gFrameClockSampledByRunner = false;
+        gFrameClockStarted = false;
+        gFrameClockFirstImGuiFrame = -1;
+    }
+
+    const FrameClock& GetFrameClock()
+    {
+        if (gFrameClockSampledByRunner)
+        {
+            if (!gFrameClockStarted)
+                Priv_SampleFrameClock();
+            return gFrameClock;
+        }
+
+        // Outside of ImmApp::Run: sampled on the first call of each ImGui frame
+        bool hasImGuiContext = ImGui::GetCurrentContext() != nullptr;
+        if (hasImGuiContext && gFrameClockStarted && ImGui::GetFrameCount() == gFrameClockImGuiFrame)
+            return gFrameClock;
+
+        double now = ClockSeconds();
+        if (gFrameClockStarted)
+            gFrameClock.deltaTime = now - gFrameClock.frameTime;
+        gFrameClock.frameTime = now;
+        if (hasImGuiContext)
+        {
+            if (gFrameClockFirstImGuiFrame < 0)
+                gFrameClockFirstImGuiFrame = ImGui::GetFrameCount();
+            gFrameClock.frameIndex = ImGui::GetFrameCount() - gFrameClockFirstImGuiFrame;
+            gFrameClockImGuiFrame = ImGui::GetFrameCount();
+        }
+        else if (gFrameClockStarted)
+            ++gFrameClock.frameIndex;
+        gFrameClockStarted = true;
+        return gFrameClock;
+    }
+
+    int FixedTimestepAccumulator::Advance(double deltaTime)
+    {
+        if (deltaTime < 0.)
+            deltaTime = GetFrameClock().deltaTime;
+        if (step <= 0.)
+            return 0;
+
+        accumulatedTime += deltaTime;
+        int nbSteps = (int)(accumulatedTime / step);
+        if (nbSteps > maxStepsPerAdvance)
+        {
+            // Drop the time we cannot catch up with
+            nbSteps = maxStepsPerAdvance;
+            accumulatedTime = 0.;
+        }
+        else
+            accumulatedTime -= nbSteps * step;
+        return nbSteps;
+    }
+
+    double FixedTimestepAccumulator::Alpha() const
     {
-        static ClockSeconds_ watch;
-        return watch.elapsed();
+        return step > 0. ? accumulatedTime / step : 0.;
     }
 
 } // namespace ImmApp
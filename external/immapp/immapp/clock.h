@@ -2,6 +2,56 @@
 
 namespace ImmApp
 {
-    // Chronometer in seconds
+    // Chronometer in seconds (monotonic)
     double ClockSeconds();
+
+    // If set to true, ClockSeconds() returns ImGui::GetTime(), i.e. a time that only advances by io.DeltaTime
+    // at each frame. Used by headless test runs with a fixed virtual time step (see RunTestsHeadless),
+    // so that animations do not depend on the machine speed.
+    // Must be called from the thread which runs ImGui: the other threads get the last ImGui time it read
+    // (the frame clock reads it before each frame).
+    void SetClockUsesImGuiTime(bool useImGuiTime);
+
+
+    // FrameClock: the clock is sampled once per frame, so that all the widgets and animations
+    // of a frame share the same time stamp (instead of each sampling the OS clock).
+    struct FrameClock
+    {
+        // Time of the current frame, in seconds (same origin as ClockSeconds())
+        double frameTime = 0.;
+        // Time elapsed between the previous frame and the current frame, in seconds
+        double deltaTime = 0.;
+        // Index of the current frame (0 for the first frame)
+        int frameIndex = 0;
+    };
+    // Returns the clock of the current frame.
+    // ImmApp::Run samples it before each frame. Outside of ImmApp::Run, it is sampled on the first call
+    // of each ImGui frame (or on each call if there is no ImGui context): frameIndex then follows
+    // ImGui::GetFrameCount(), and deltaTime is the time elapsed since the previous call.
+    const FrameClock& GetFrameClock();
+
+
+    // FixedTimestepAccumulator: helps to advance an animation or a simulation by fixed steps,
+    // independently of the frame rate. Usage:
+    //     static ImmApp::FixedTimestepAccumulator accumulator(1. / 60.);
+    //     int nbSteps = accumulator.Advance();
+    //     for (int i = 0; i < nbSteps; ++i)
+    //         MySimulationStep(accumulator.step);
+    struct FixedTimestepAccumulator
+    {
+        // Duration of a step, in seconds
+        double step = 1. / 60.;
+        // Maximum number of steps returned by Advance (avoids a spiral of death after a long hitch)
+        int maxStepsPerAdvance = 8;
+        // Time accumulated, which was not yet consumed by steps
+        double accumulatedTime = 0.;
+
+        FixedTimestepAccumulator(double step_ = 1. / 60.) : step(step_) {}
+
+        // Accumulates deltaTime (or the frame clock deltaTime, if deltaTime < 0),
+        // and returns the number of steps to perform
+        int Advance(double deltaTime = -1.);
+        // Position between the last step and the next one, in [0, 1[ (useful to interpolate the display)
+        double Alpha() const;
+    };
 } // namespace ImmApp
@@ -0,0 +1,667 @@
+#include "immapp/draw_data_stream.h"
+#include "immapp/clock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        // Packet layout (all integers are LEB128 varints, signed ones are zigzag encoded):
+        //   u8 version | u8 flags | frameIndex | displayPos, displaySize, framebufferScale (6 raw floats)
+        //   | positionSubdivisions | nbLists | lists...
+        // A list is either:
+        //   u8 ListTag_Previous | index in the previous frame | originX | originY
+        //   u8 ListTag_Encoded | originX | originY | nbVtx | nbIdx | vertex span | index span | commands
+        //   u8 ListTag_Delta | index in the previous frame | originX | originY | nbVtx | nbIdx
+        //       | vtxPrefix | vtxSuffix | vertex span | idxPrefix | idxSuffix | index span | commands
+        // where:
+        //   vertex span: nbColors | colors (raw u32) | vertices (delta coded, as indices into the colors)
+        //   index span: indices (delta coded)
+        //   commands: nbCmd | commands
+        // The positions and clip rects of a list are encoded relative to its origin (its first vertex, quantized):
+        // a list which was only moved (e.g. a moved window) has the same encoding, and is sent as a reference.
+        const uint8_t kStreamVersion = 3;
+        const uint8_t kFlag_KeyFrame = 1;
+        enum ListTag : uint8_t { ListTag_Previous = 0, ListTag_Encoded = 1, ListTag_Delta = 2 };
+
+        // Writer
+        void WriteU8(std::vector<uint8_t>& out, uint8_t v) { out.push_back(v); }
+        void WriteVarint(std::vector<uint8_t>& out, uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                out.push_back((uint8_t)(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back((uint8_t)v);
+        }
+        void WriteSigned(std::vector<uint8_t>& out, int64_t v)
+        {
+            WriteVarint(out, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+        }
+        void WriteRaw(std::vector<uint8_t>& out, const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        // Reader: all reads fail (and return 0) once the end of the packet is reached
+        struct Reader
+        {
+            const uint8_t* data;
+            size_t size;
+            size_t pos = 0;
+            bool failed = false;
+
+            uint8_t ReadU8()
+            {
+                if (pos >= size) { failed = true; return 0; }
+                return data[pos++];
+            }
+            uint64_t ReadVarint()
+            {
+                uint64_t v = 0;
+                for (int shift = 0; shift < 64; shift += 7)
+                {
+                    uint8_t byte = ReadU8();
+                    v |= (uint64_t)(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                        return v;
+                }
+                failed = true;
+                return 0;
+            }
+            int64_t ReadSigned()
+            {
+                uint64_t v = ReadVarint();
+                return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+            }
+            void ReadRaw(void* dst, size_t n)
+            {
+                if (n == 0)
+                    return;
+                if (n > size - pos) { failed = true; memset(dst, 0, n); return; }
+                memcpy(dst, data + pos, n);
+                pos += n;
+            }
+            // Guards against allocating huge buffers from a corrupted count
+            bool CanContain(uint64_t nbItems) const { return !failed && nbItems <= size - pos; }
+        };
+
+        int64_t Quantize(float v, float scale)
+        {
+            double q = std::round((double)v * scale);
+            return (int64_t)std::clamp(q, -1e12, 1e12);
+        }
+
+        uint64_t HashBytes(const std::vector<uint8_t>& bytes)
+        {
+            uint64_t h = 0xcbf29ce484222325ULL ^ bytes.size();
+            size_t i = 0;
+            for (; i + 8 <= bytes.size(); i += 8)
+            {
+                uint64_t word;
+                memcpy(&word, bytes.data() + i, 8);
+                h = (h ^ word) * 0x9E3779B97F4A7C15ULL;
+                h ^= h >> 29;
+            }
+            for (; i < bytes.size(); ++i)
+                h = (h ^ bytes[i]) * 0x100000001b3ULL;
+            return h;
+        }
+
+        // Writes the vertices [begin, end) of a list: a palette (UI draw lists use few distinct colors),
+        // then the vertices, delta coded from the previous one
+        void WriteVertexSpan(std::vector<uint8_t>& out, const QuantizedVertex* vertices, size_t begin, size_t end)
+        {
+            std::unordered_map<ImU32, uint32_t> paletteIndices;
+            std::vector<ImU32> palette;
+            for (size_t i = begin; i < end; ++i)
+                if ((i == begin || vertices[i].col != vertices[i - 1].col)
+                    && paletteIndices.emplace(vertices[i].col, (uint32_t)palette.size()).second)
+                    palette.push_back(vertices[i].col);
+            WriteVarint(out, palette.size());
+            WriteRaw(out, palette.data(), palette.size() * sizeof(ImU32));
+
+            QuantizedVertex prev{};
+            uint32_t prevColorIndex = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                const QuantizedVertex& v = vertices[i];
+                WriteSigned(out, v.x - prev.x);
+                WriteSigned(out, v.y - prev.y);
+                WriteSigned(out, v.u - prev.u);
+                WriteSigned(out, v.v - prev.v);
+                // Consecutive vertices usually share their color
+                if (i == begin || v.col != prev.col)
+                    prevColorIndex = paletteIndices[v.col];
+                WriteVarint(out, prevColorIndex);
+                prev = v;
+            }
+        }
+
+        // Writes the indices [begin, end) of a list, delta coded (starting from prevIdx)
+        void WriteIndexSpan(std::vector<uint8_t>& out, const ImDrawIdx* indices, size_t begin, size_t end, int64_t prevIdx)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                WriteSigned(out, (int64_t)indices[i] - prevIdx);
+                prevIdx = indices[i];
+            }
+        }
+
+        // Quantizes a draw list relative to its origin, and computes its full encoding (without its tag and origin)
+        void QuantizeDrawList(const ImDrawList* drawList, ImVec2 displayPos, float positionScale,
+                              EncodedDrawList* outList, int64_t* outOriginX, int64_t* outOriginY)
+        {
+            const ImDrawVert* vertices = drawList->VtxBuffer.Data;
+            int nbVtx = drawList->VtxBuffer.Size;
+
+            // Quantized positions are relative to displayPos, then to the origin
+            int64_t originX = 0, originY = 0;
+            if (nbVtx > 0)
+            {
+                originX = Quantize(vertices[0].pos.x - displayPos.x, positionScale);
+                originY = Quantize(vertices[0].pos.y - displayPos.y, positionScale);
+            }
+            *outOriginX = originX;
+            *outOriginY = originY;
+
+            outList->vertices.resize(nbVtx);
+            for (int i = 0; i < nbVtx; ++i)
+            {
+                const ImDrawVert& v = vertices[i];
+                QuantizedVertex& q = outList->vertices[i];
+                q.x = Quantize(v.pos.x - displayPos.x, positionScale) - originX;
+                q.y = Quantize(v.pos.y - displayPos.y, positionScale) - originY;
+                q.u = Quantize(v.uv.x, 65535.f);
+                q.v = Quantize(v.uv.y, 65535.f);
+                q.col = v.col;
+            }
+            outList->indices.assign(drawList->IdxBuffer.begin(), drawList->IdxBuffer.end());
+
+            // Commands: user callbacks cannot be remoted
+            std::vector<uint8_t>& cmdBytes = outList->commandBytes;
+            cmdBytes.clear();
+            int nbCmd = 0;
+            for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+                if (cmd.UserCallback == nullptr && cmd.ElemCount > 0)
+                    ++nbCmd;
+            WriteVarint(cmdBytes, (uint64_t)nbCmd);
+            for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+            {
+                if (cmd.UserCallback != nullptr || cmd.ElemCount == 0)
+                    continue;
+                WriteSigned(cmdBytes, Quantize(cmd.ClipRect.x - displayPos.x, positionScale) - originX);
+                WriteSigned(cmdBytes, Quantize(cmd.ClipRect.y - displayPos.y, positionScale) - originY);
+                WriteSigned(cmdBytes, Quantize(cmd.ClipRect.z - displayPos.x, positionScale) - originX);
+                WriteSigned(cmdBytes, Quantize(cmd.ClipRect.w - displayPos.y, positionScale) - originY);
+                WriteVarint(cmdBytes, (uint64_t)(ImU64)cmd.GetTexID());
+                WriteVarint(cmdBytes, cmd.VtxOffset);
+                WriteVarint(cmdBytes, cmd.IdxOffset);
+                WriteVarint(cmdBytes, cmd.ElemCount);
+            }
+
+            std::vector<uint8_t>& out = outList->bytes;
+            out.clear();
+            WriteVarint(out, outList->vertices.size());
+            WriteVarint(out, outList->indices.size());
+            WriteVertexSpan(out, outList->vertices.data(), 0, outList->vertices.size());
+            WriteIndexSpan(out, outList->indices.data(), 0, outList->indices.size(), 0);
+            WriteRaw(out, cmdBytes.data(), cmdBytes.size());
+            outList->hash = HashBytes(out);
+        }
+
+        // Lengths of the common prefix and suffix of two sequences (which do not overlap)
+        template<typename T, typename Equal>
+        void CommonPrefixAndSuffix(const std::vector<T>& a, const std::vector<T>& b, Equal equal,
+                                   size_t* outPrefix, size_t* outSuffix)
+        {
+            size_t maxLength = std::min(a.size(), b.size());
+            size_t prefix = 0;
+            while (prefix < maxLength && equal(a, prefix, b, prefix))
+                ++prefix;
+            size_t suffix = 0;
+            while (prefix + suffix < maxLength && equal(a, a.size() - 1 - suffix, b, b.size() - 1 - suffix))
+                ++suffix;
+            *outPrefix = prefix;
+            *outSuffix = suffix;
+        }
+
+        // Encodes a list as a delta from a list of the previous frame (without its tag, base index and origin):
+        // only the vertices and indices between their common prefix and suffix are sent.
+        // The indices are compared by their difference to the previous index, so that the indices which follow
+        // inserted or removed vertices (i.e. shifted by a constant) are still part of the common suffix.
+        void EncodeDelta(const EncodedDrawList& base, const EncodedDrawList& list, std::vector<uint8_t>& out)
+        {
+            size_t vtxPrefix, vtxSuffix;
+            CommonPrefixAndSuffix(base.vertices, list.vertices,
+                [](const std::vector<QuantizedVertex>& a, size_t i, const std::vector<QuantizedVertex>& b, size_t j) {
+                    return a[i] == b[j];
+                },
+                &vtxPrefix, &vtxSuffix);
+            size_t idxPrefix, idxSuffix;
+            CommonPrefixAndSuffix(base.indices, list.indices,
+                [](const std::vector<ImDrawIdx>& a, size_t i, const std::vector<ImDrawIdx>& b, size_t j) {
+                    int64_t deltaA = (int64_t)a[i] - (i > 0 ? (int64_t)a[i - 1] : 0);
+                    int64_t deltaB = (int64_t)b[j] - (j > 0 ? (int64_t)b[j - 1] : 0);
+                    return deltaA == deltaB;
+                },
+                &idxPrefix, &idxSuffix);
+
+            WriteVarint(out, list.vertices.size());
+            WriteVarint(out, list.indices.size());
+            WriteVarint(out, vtxPrefix);
+            WriteVarint(out, vtxSuffix);
+            WriteVertexSpan(out, list.vertices.data(), vtxPrefix, list.vertices.size() - vtxSuffix);
+            WriteVarint(out, idxPrefix);
+            WriteVarint(out, idxSuffix);
+            int64_t prevIdx = idxPrefix > 0 ? list.indices[idxPrefix - 1] : 0;
+            WriteIndexSpan(out, list.indices.data(), idxPrefix, list.indices.size() - idxSuffix, prevIdx);
+            WriteRaw(out, list.commandBytes.data(), list.commandBytes.size());
+        }
+
+        // Reads nbVtx vertices into outVertices (see WriteVertexSpan)
+        bool ReadVertexSpan(Reader& reader, float positionScale, size_t nbVtx, ImDrawVert* outVertices)
+        {
+            uint64_t nbColors = reader.ReadVarint();
+            if (!reader.CanContain(nbColors) || !reader.CanContain(nbColors * sizeof(ImU32)))
+                return false;
+            std::vector<ImU32> palette(nbColors);
+            reader.ReadRaw(palette.data(), nbColors * sizeof(ImU32));
+
+            float invScale = 1.f / positionScale;
+            int64_t x = 0, y = 0, u = 0, v = 0;
+            for (size_t i = 0; i < nbVtx; ++i)
+            {
+                x += reader.ReadSigned();
+                y += reader.ReadSigned();
+                u += reader.ReadSigned();
+                v += reader.ReadSigned();
+                uint64_t colorIndex = reader.ReadVarint();
+                if (colorIndex >= nbColors)
+                    return false;
+                ImDrawVert& vtx = outVertices[i];
+                vtx.pos = ImVec2((float)x * invScale, (float)y * invScale);
+                vtx.uv = ImVec2((float)u / 65535.f, (float)v / 65535.f);
+                vtx.col = palette[colorIndex];
+            }
+            return !reader.failed;
+        }
+
+        // Reads nbIdx indices into outIndices, delta coded from prevIdx (see WriteIndexSpan)
+        bool ReadIndexSpan(Reader& reader, size_t nbIdx, int64_t prevIdx, ImDrawIdx* outIndices)
+        {
+            const int64_t maxIdx = (int64_t)(ImDrawIdx)~(ImDrawIdx)0;
+            int64_t idx = prevIdx;
+            for (size_t i = 0; i < nbIdx; ++i)
+            {
+                idx += reader.ReadSigned();
+                if (idx < 0 || idx > maxIdx)
+                    return false;
+                outIndices[i] = (ImDrawIdx)idx;
+            }
+            return !reader.failed;
+        }
+
+        // Reads the commands of a list.
+        // The commands must only refer to existing vertices and indices: the client renderer does not check them
+        bool ReadCommands(Reader& reader, float positionScale, DecodedDrawList* list)
+        {
+            uint64_t nbCmd = reader.ReadVarint();
+            if (!reader.CanContain(nbCmd))
+                return false;
+            float invScale = 1.f / positionScale;
+            size_t nbVtx = list->VtxBuffer.size(), nbIdx = list->IdxBuffer.size();
+            list->CmdBuffer.resize(nbCmd);
+            for (DecodedDrawCmd& cmd : list->CmdBuffer)
+            {
+                cmd.ClipRect.x = (float)reader.ReadSigned() * invScale;
+                cmd.ClipRect.y = (float)reader.ReadSigned() * invScale;
+                cmd.ClipRect.z = (float)reader.ReadSigned() * invScale;
+                cmd.ClipRect.w = (float)reader.ReadSigned() * invScale;
+                cmd.TextureId = reader.ReadVarint();
+                uint64_t vtxOffset = reader.ReadVarint();
+                uint64_t idxOffset = reader.ReadVarint();
+                uint64_t elemCount = reader.ReadVarint();
+                if (vtxOffset >= nbVtx || idxOffset > nbIdx || elemCount > nbIdx - idxOffset)
+                    return false;
+                for (uint64_t i = idxOffset; i < idxOffset + elemCount; ++i)
+                    if (vtxOffset + list->IdxBuffer[i] >= nbVtx)
+                        return false;
+                cmd.VtxOffset = (unsigned int)vtxOffset;
+                cmd.IdxOffset = (unsigned int)idxOffset;
+                cmd.ElemCount = (unsigned int)elemCount;
+            }
+            return !reader.failed;
+        }
+
+        // Decodes the contents of a list, relative to its origin (see TranslateDrawList)
+        bool DecodeDrawList(Reader& reader, float positionScale, DecodedDrawList* outList)
+        {
+            uint64_t nbVtx = reader.ReadVarint();
+            uint64_t nbIdx = reader.ReadVarint();
+            // Each item takes at least one byte
+            if (!reader.CanContain(nbVtx) || !reader.CanContain(nbIdx))
+                return false;
+            outList->VtxBuffer.resize(nbVtx);
+            outList->IdxBuffer.resize(nbIdx);
+            return ReadVertexSpan(reader, positionScale, nbVtx, outList->VtxBuffer.data())
+                && ReadIndexSpan(reader, nbIdx, 0, outList->IdxBuffer.data())
+                && ReadCommands(reader, positionScale, outList);
+        }
+
+        // Decodes a list sent as a delta from a list of the previous frame (see EncodeDelta)
+        bool DecodeDelta(Reader& reader, float positionScale, const DecodedDrawList& base, DecodedDrawList* outList)
+        {
+            uint64_t nbVtx = reader.ReadVarint();
+            uint64_t nbIdx = reader.ReadVarint();
+            uint64_t vtxPrefix = reader.ReadVarint();
+            uint64_t vtxSuffix = reader.ReadVarint();
+            const uint64_t baseNbVtx = base.VtxBuffer.size(), baseNbIdx = base.IdxBuffer.size();
+            if (reader.failed || vtxPrefix > baseNbVtx || vtxSuffix > baseNbVtx - vtxPrefix
+                || vtxPrefix > nbVtx || vtxSuffix > nbVtx - vtxPrefix
+                || !reader.CanContain(nbVtx - vtxPrefix - vtxSuffix))
+                return false;
+            std::vector<ImDrawVert>& vertices = outList->VtxBuffer;
+            vertices.resize(nbVtx);
+            std::copy(base.VtxBuffer.begin(), base.VtxBuffer.begin() + vtxPrefix, vertices.begin());
+            std::copy(base.VtxBuffer.end() - vtxSuffix, base.VtxBuffer.end(), vertices.end() - vtxSuffix);
+            if (!ReadVertexSpan(reader, positionScale, nbVtx - vtxPrefix - vtxSuffix, vertices.data() + vtxPrefix))
+                return false;
+
+            uint64_t idxPrefix = reader.ReadVarint();
+            uint64_t idxSuffix = reader.ReadVarint();
+            if (reader.failed || idxPrefix > baseNbIdx || idxSuffix > baseNbIdx - idxPrefix
+                || idxPrefix > nbIdx || idxSuffix > nbIdx - idxPrefix
+                || !reader.CanContain(nbIdx - idxPrefix - idxSuffix))
+                return false;
+            std::vector<ImDrawIdx>& indices = outList->IdxBuffer;
+            indices.resize(nbIdx);
+            std::copy(base.IdxBuffer.begin(), base.IdxBuffer.begin() + idxPrefix, indices.begin());
+            int64_t prevIdx = idxPrefix > 0 ? indices[idxPrefix - 1] : 0;
+            size_t nbMiddleIdx = nbIdx - idxPrefix - idxSuffix;
+            if (!ReadIndexSpan(reader, nbMiddleIdx, prevIdx, indices.data() + idxPrefix))
+                return false;
+            // The suffix has the same differences between consecutive indices as in the base list
+            const int64_t maxIdx = (int64_t)(ImDrawIdx)~(ImDrawIdx)0;
+            int64_t idx = (idxPrefix + nbMiddleIdx) > 0 ? indices[idxPrefix + nbMiddleIdx - 1] : 0;
+            for (uint64_t k = baseNbIdx - idxSuffix, i = nbIdx - idxSuffix; k < baseNbIdx; ++k, ++i)
+            {
+                idx += (int64_t)base.IdxBuffer[k] - (k > 0 ? (int64_t)base.IdxBuffer[k - 1] : 0);
+                if (idx < 0 || idx > maxIdx)
+                    return false;
+                indices[i] = (ImDrawIdx)idx;
+            }
+            return ReadCommands(reader, positionScale, outList);
+        }
+
+        // Moves a decoded list from its origin to its position on the display
+        void TranslateDrawList(DecodedDrawList* list, ImVec2 offset)
+        {
+            for (ImDrawVert& vtx : list->VtxBuffer)
+            {
+                vtx.pos.x += offset.x;
+                vtx.pos.y += offset.y;
+            }
+            for (DecodedDrawCmd& cmd : list->CmdBuffer)
+            {
+                cmd.ClipRect.x += offset.x;
+                cmd.ClipRect.y += offset.y;
+                cmd.ClipRect.z += offset.x;
+                cmd.ClipRect.w += offset.y;
+            }
+        }
+    } // anonymous namespace
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DrawDataStreamEncoder
+    ///////////////////////////////////////////////////////////////////////////
+    DrawDataStreamEncoder::DrawDataStreamEncoder(const DrawDataStreamParams& params)
+        : mParams(params), mBandwidth(params.initialBandwidth)
+    {
+    }
+
+    void DrawDataStreamEncoder::EncodeFrame(const ImDrawData* drawData, std::vector<uint8_t>* outPacket, double now)
+    {
+        IM_ASSERT(drawData != nullptr && outPacket != nullptr);
+        std::vector<uint8_t>& out = *outPacket;
+        out.clear();
+
+        bool isKeyFrame = mPreviousLists.empty();
+        WriteU8(out, kStreamVersion);
+        WriteU8(out, isKeyFrame ? kFlag_KeyFrame : 0);
+        WriteVarint(out, mFrameIndex++);
+        WriteRaw(out, &drawData->DisplayPos, sizeof(ImVec2));
+        WriteRaw(out, &drawData->DisplaySize, sizeof(ImVec2));
+        WriteRaw(out, &drawData->FramebufferScale, sizeof(ImVec2));
+        WriteVarint(out, (uint64_t)mParams.positionSubdivisions);
+        WriteVarint(out, (uint64_t)drawData->CmdListsCount);
+
+        // Previous lists, by hash of their encoding
+        std::unordered_multimap<uint64_t, size_t> previousListsByHash;
+        for (size_t i = 0; i < mPreviousLists.size(); ++i)
+            previousListsByHash.emplace(mPreviousLists[i].hash, i);
+
+        float positionScale = (float)mParams.positionSubdivisions;
+        mCurrentLists.resize(drawData->CmdListsCount);
+        for (int n = 0; n < drawData->CmdListsCount; ++n)
+        {
+            EncodedDrawList& encodedList = mCurrentLists[n];
+            int64_t originX, originY;
+            QuantizeDrawList(drawData->CmdLists[n], drawData->DisplayPos, positionScale, &encodedList, &originX, &originY);
+
+            bool sentAsReference = false;
+            auto range = previousListsByHash.equal_range(encodedList.hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (mPreviousLists[it->second].bytes == encodedList.bytes)
+                {
+                    WriteU8(out, ListTag_Previous);
+                    WriteVarint(out, it->second);
+                    WriteSigned(out, originX);
+                    WriteSigned(out, originY);
+                    sentAsReference = true;
+                    break;
+                }
+            }
+            if (sentAsReference)
+                continue;
+
+            // Delta from the list at the same position in the previous frame, if smaller
+            mDeltaBytes.clear();
+            if ((size_t)n < mPreviousLists.size())
+                EncodeDelta(mPreviousLists[n], encodedList, mDeltaBytes);
+            if (!mDeltaBytes.empty() && mDeltaBytes.size() < encodedList.bytes.size())
+            {
+                WriteU8(out, ListTag_Delta);
+                WriteVarint(out, (uint64_t)n);
+                WriteSigned(out, originX);
+                WriteSigned(out, originY);
+                WriteRaw(out, mDeltaBytes.data(), mDeltaBytes.size());
+            }
+            else
+            {
+                WriteU8(out, ListTag_Encoded);
+                WriteSigned(out, originX);
+                WriteSigned(out, originY);
+                WriteRaw(out, encodedList.bytes.data(), encodedList.bytes.size());
+            }
+        }
+        std::swap(mPreviousLists, mCurrentLists);
+        mInFlightBytes += out.size();
+        mLastSendTime = now >= 0. ? now : ClockSeconds();
+    }
+
+    void DrawDataStreamEncoder::RequestKeyFrame()
+    {
+        mPreviousLists.clear();
+    }
+
+    bool DrawDataStreamEncoder::ShallSendFrame(double now) const
+    {
+        if (now - mLastSendTime < mParams.minFrameInterval)
+            return false;
+        double drainDuration = (double)mInFlightBytes / std::max(mBandwidth, 1.);
+        return drainDuration <= mParams.minFrameInterval;
+    }
+
+    void DrawDataStreamEncoder::OnPacketDelivered(size_t packetSize, double transferDuration)
+    {
+        mInFlightBytes -= std::min(mInFlightBytes, packetSize);
+        if (transferDuration <= 0.)
+            return;
+        double measuredBandwidth = (double)packetSize / transferDuration;
+        // Exponential moving average, which reacts within a few packets
+        const double k = 0.25;
+        mBandwidth = mBandwidth * (1. - k) + measuredBandwidth * k;
+    }
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // DrawDataStreamDecoder
+    ///////////////////////////////////////////////////////////////////////////
+    bool DrawDataStreamDecoder::DecodeFrame(const uint8_t* packet, size_t packetSize)
+    {
+        Reader reader{ packet, packetSize };
+        if (reader.ReadU8() != kStreamVersion)
+            return false;
+        uint8_t flags = reader.ReadU8();
+        bool isKeyFrame = (flags & kFlag_KeyFrame) != 0;
+        uint64_t newFrameIndex = reader.ReadVarint();
+        ImVec2 newDisplayPos, newDisplaySize, newFramebufferScale;
+        reader.ReadRaw(&newDisplayPos, sizeof(ImVec2));
+        reader.ReadRaw(&newDisplaySize, sizeof(ImVec2));
+        reader.ReadRaw(&newFramebufferScale, sizeof(ImVec2));
+        uint64_t positionSubdivisions = reader.ReadVarint();
+        uint64_t nbLists = reader.ReadVarint();
+        if (reader.failed || positionSubdivisions == 0 || !reader.CanContain(nbLists))
+            return false;
+
+        // Lists may only refer to the previous frame: if a packet was lost or rejected, they are rejected
+        // until a key frame is received
+        bool canReferToPrevious = !isKeyFrame && newFrameIndex == frameIndex + 1;
+
+        float positionScale = (float)positionSubdivisions;
+        float invScale = 1.f / positionScale;
+        // The lists relative to their origin (kept for the next packet), and the translated lists
+        std::vector<DecodedDrawList> newLists(nbLists);
+        std::vector<DecodedDrawList> newDrawLists(nbLists);
+        bool ok = true;
+        for (size_t n = 0; n < newLists.size() && ok; ++n)
+        {
+            DecodedDrawList& list = newLists[n];
+            uint8_t tag = reader.ReadU8();
+            const DecodedDrawList* base = nullptr;
+            if (tag == ListTag_Previous || tag == ListTag_Delta)
+            {
+                uint64_t previousIndex = reader.ReadVarint();
+                if (!canReferToPrevious || previousIndex >= mPreviousLists.size())
+                    ok = false;
+                else
+                    base = &mPreviousLists[previousIndex];
+            }
+            int64_t originX = reader.ReadSigned();
+            int64_t originY = reader.ReadSigned();
+            if (!ok)
+                break;
+            if (tag == ListTag_Previous)
+                list = *base;
+            else if (tag == ListTag_Delta)
+                ok = DecodeDelta(reader, positionScale, *base, &list);
+            else if (tag == ListTag_Encoded)
+                ok = DecodeDrawList(reader, positionScale, &list);
+            else
+                ok = false;
+            if (!ok)
+                break;
+            newDrawLists[n] = list;
+            TranslateDrawList(&newDrawLists[n], ImVec2((float)originX * invScale + newDisplayPos.x,
+                                                       (float)originY * invScale + newDisplayPos.y));
+        }
+        if (!ok || reader.failed)
+        {
+            // The next packets may refer to lists which we could not decode: they will fail until a packet
+            // without references (such as a key frame) is received
+            mPreviousLists.clear();
+            return false;
+        }
+
+        frameIndex = newFrameIndex;
+        displayPos = newDisplayPos;
+        displaySize = newDisplaySize;
+        framebufferScale = newFramebufferScale;
+        mPreviousLists = std::move(newLists);
+        drawLists = std::move(newDrawLists);
+        return true;
+    }
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // RemotingLoopback
+    ///////////////////////////////////////////////////////////////////////////
+    RemotingLoopback::RemotingLoopback(const RemotingLinkParams& linkParams, const DrawDataStreamParams& streamParams)
+        : mLinkParams(linkParams), mEncoder(streamParams)
+    {
+    }
+
+    void RemotingLoopback::DeliverPackets(double now)
+    {
+        while (!mInFlightPackets.empty() && mInFlightPackets.front().deliveryTime <= now)
+        {
+            InFlightPacket& packet = mInFlightPackets.front();
+
+            double decodeStart = ClockSeconds();
+            bool decoded = mDecoder.DecodeFrame(packet.bytes.data(), packet.bytes.size());
+            mStats.decodeDuration += ClockSeconds() - decodeStart;
+
+            mEncoder.OnPacketDelivered(packet.bytes.size(), packet.transferDuration);
+            if (decoded)
+            {
+                ++mStats.nbFramesDecoded;
+                mStats.lastLatency = packet.deliveryTime - packet.sendTime;
+                mStats.averageLatency += (mStats.lastLatency - mStats.averageLatency) / mStats.nbFramesDecoded;
+            }
+            mInFlightPackets.pop_front();
+        }
+    }
+
+    void RemotingLoopback::OnFrameRendered(const ImDrawData* drawData, double now)
+    {
+        if (now < 0.)
+            now = ClockSeconds();
+        ++mStats.nbFramesRendered;
+        DeliverPackets(now);
+        if (drawData == nullptr || !mEncoder.ShallSendFrame(now))
+            return;
+
+        InFlightPacket packet;
+        double encodeStart = ClockSeconds();
+        mEncoder.EncodeFrame(drawData, &packet.bytes, now);
+        mStats.encodeDuration += ClockSeconds() - encodeStart;
+
+        for (int n = 0; n < drawData->CmdListsCount; ++n)
+        {
+            const ImDrawList* drawList = drawData->CmdLists[n];
+            mStats.rawBytes += (double)drawList->VtxBuffer.Size * sizeof(ImDrawVert)
+                             + (double)drawList->IdxBuffer.Size * sizeof(ImDrawIdx)
+                             + (double)drawList->CmdBuffer.Size * sizeof(ImDrawCmd);
+        }
+        ++mStats.nbFramesSent;
+        mStats.bytesSent += (double)packet.bytes.size();
+
+        // The link transfers one packet at a time
+        packet.sendTime = now;
+        packet.transferDuration = (double)packet.bytes.size() / mLinkParams.bandwidth;
+        double transferStart = std::max(now, mLinkBusyUntil);
+        mLinkBusyUntil = transferStart + packet.transferDuration;
+        packet.deliveryTime = mLinkBusyUntil + mLinkParams.latency;
+        mInFlightPackets.push_back(std::move(packet));
+    }
+} // namespace ImmApp
@@ -0,0 +1,180 @@
+#pragma once
+#include "imgui.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+
+namespace ImmApp
+{
+    // Draw data streaming: a compact encoding of ImDrawData, for remoting over slow links.
+    //
+    // - Each frame is encoded as a packet. Draw lists which are identical to a draw list of the previous frame,
+    //   up to a translation (e.g. windows which did not change, or were only moved), are sent as a reference to it.
+    // - The other draw lists are compressed: positions are quantized (see DrawDataStreamParams) and delta coded,
+    //   uvs are quantized to 16 bits, colors are sent as indices into a per-list palette, and indices are delta coded.
+    // - A draw list which changed is sent as a delta from the list at the same position in the previous frame,
+    //   when it is smaller: only the vertices and indices between their common prefix and suffix are sent
+    //   (e.g. a text which changed inside a window). The commands are always sent.
+    // - The frame rate adapts to the measured bandwidth: see ShallSendFrame() and OnPacketDelivered().
+    //
+    // The packets must be delivered in order, and all of them (e.g. over a websocket): each packet may refer
+    // to the previous one. Textures are not streamed: the client must know the textures (e.g. the font atlas)
+    // by their ImTextureID.
+
+    struct DrawDataStreamParams
+    {
+        // Positions and clip rects are rounded to 1 / positionSubdivisions pixels
+        int positionSubdivisions = 16;
+        // The frame rate will not exceed 1 / minFrameInterval
+        double minFrameInterval = 1. / 60.;
+        // Initial bandwidth estimation (bytes per second), before the first packet is delivered
+        double initialBandwidth = 1e6;
+    };
+
+
+    // A draw list, as encoded by DrawDataStreamEncoder (positions are relative to the list origin)
+    struct QuantizedVertex
+    {
+        int64_t x, y, u, v;
+        ImU32 col;
+        bool operator==(const QuantizedVertex& o) const { return x == o.x && y == o.y && u == o.u && v == o.v && col == o.col; }
+    };
+    struct EncodedDrawList
+    {
+        std::vector<QuantizedVertex> vertices;
+        std::vector<ImDrawIdx> indices;
+        std::vector<uint8_t> commandBytes;
+        std::vector<uint8_t> bytes;         // The full encoding
+        uint64_t hash = 0;                  // Hash of bytes
+    };
+
+
+    class DrawDataStreamEncoder
+    {
+    public:
+        explicit DrawDataStreamEncoder(const DrawDataStreamParams& params = DrawDataStreamParams());
+
+        // Encodes a frame into a packet (now: send time, default ClockSeconds())
+        void EncodeFrame(const ImDrawData* drawData, std::vector<uint8_t>* outPacket, double now = -1.);
+        // The next packet will not refer to the previous frame (e.g. when a new client connects)
+        void RequestKeyFrame();
+
+        // Adaptive frame rate: returns true if a frame shall be sent now, i.e. if the packets which are still
+        // in flight can be transferred within minFrameInterval at the estimated bandwidth
+        // (so that the frames do not queue up in the link, which would increase the latency)
+        bool ShallSendFrame(double now) const;
+        // Shall be called by the transport when a packet was delivered: transferDuration is the time it took
+        // to transfer it (not including the latency), from which the bandwidth is estimated
+        void OnPacketDelivered(size_t packetSize, double transferDuration);
+        double EstimatedBandwidth() const { return mBandwidth; }
+
+    private:
+        DrawDataStreamParams mParams;
+        std::vector<EncodedDrawList> mPreviousLists;
+        std::vector<EncodedDrawList> mCurrentLists;
+        std::vector<uint8_t> mDeltaBytes;
+        uint64_t mFrameIndex = 0;
+        double mBandwidth;
+        double mLastSendTime = -1e30;
+        size_t mInFlightBytes = 0;
+    };
+
+
+    struct DecodedDrawCmd
+    {
+        ImVec4 ClipRect;
+        ImU64 TextureId;
+        unsigned int VtxOffset;
+        unsigned int IdxOffset;
+        unsigned int ElemCount;
+    };
+
+    struct DecodedDrawList
+    {
+        std::vector<ImDrawVert> VtxBuffer;
+        std::vector<ImDrawIdx> IdxBuffer;
+        std::vector<DecodedDrawCmd> CmdBuffer;
+    };
+
+    // The client side: decodes the packets of a DrawDataStreamEncoder
+    class DrawDataStreamDecoder
+    {
+    public:
+        // Returns false if the packet is invalid (including commands which refer to vertices or indices
+        // out of their list), or refers to a list which could not be decoded
+        bool DecodeFrame(const uint8_t* packet, size_t packetSize);
+
+        ImVec2 displayPos, displaySize, framebufferScale;
+        std::vector<DecodedDrawList> drawLists;
+        uint64_t frameIndex = 0;
+
+    private:
+        // The lists of the previous frame, relative to their origin
+        std::vector<DecodedDrawList> mPreviousLists;
+    };
+
+
+    // A local stand-in for a remote client: the frames are encoded, sent through a simulated link,
+    // and decoded, so that the throughput and the latency can be measured on one machine.
+    // Usage:
+    //     ImmApp::RemotingLinkParams vpnLink;
+    //     vpnLink.bandwidth = 250e3;
+    //     ImmApp::RemotingLoopback loopback(vpnLink);
+    //     runnerParams.callbacks.AfterSwap = [&] { loopback.OnFrameRendered(ImGui::GetDrawData()); };
+    struct RemotingLinkParams
+    {
+        // Bytes per second
+        double bandwidth = 1e6;
+        // One way latency, in seconds
+        double latency = 0.03;
+    };
+
+    struct RemotingLoopbackStats
+    {
+        int nbFramesRendered = 0;
+        int nbFramesSent = 0;
+        int nbFramesDecoded = 0;
+        // Total size of the packets, and of the draw data they encode (vertices, indices and commands)
+        double bytesSent = 0.;
+        double rawBytes = 0.;
+        // Delay between the encoding and the decoding of a frame (average, and last)
+        double averageLatency = 0.;
+        double lastLatency = 0.;
+        // CPU time spent to encode and decode, in seconds
+        double encodeDuration = 0.;
+        double decodeDuration = 0.;
+    };
+
+    class RemotingLoopback
+    {
+    public:
+        explicit RemotingLoopback(const RemotingLinkParams& linkParams = RemotingLinkParams(),
+                                  const DrawDataStreamParams& streamParams = DrawDataStreamParams());
+
+        // Call this after each frame (e.g. in runnerParams.callbacks.AfterSwap)
+        void OnFrameRendered(const ImDrawData* drawData, double now = -1.);
+
+        const RemotingLoopbackStats& Stats() const { return mStats; }
+        const DrawDataStreamDecoder& Client() const { return mDecoder; }
+
+    private:
+        struct InFlightPacket
+        {
+            std::vector<uint8_t> bytes;
+            double sendTime;
+            double transferDuration;
+            double deliveryTime;
+        };
+        void DeliverPackets(double now);
+
+        RemotingLinkParams mLinkParams;
+        DrawDataStreamEncoder mEncoder;
+        DrawDataStreamDecoder mDecoder;
+        std::deque<InFlightPacket> mInFlightPackets;
+        double mLinkBusyUntil = 0.;
+        RemotingLoopbackStats mStats;
+    };
+} // namespace ImmApp
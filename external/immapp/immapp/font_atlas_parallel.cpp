@@ -0,0 +1,292 @@
+#include "immapp/font_atlas_parallel.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define IMMAPP_FONT_ATLAS_NO_THREADS
+#endif
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        // A font, and the sources merged into it (they are contiguous in ImFontAtlas::Sources)
+        struct FontSourcesGroup
+        {
+            ImFont* dstFont = nullptr;
+            int firstSource = 0;
+            int nbSources = 0;
+            double estimatedCost = 0.;
+        };
+
+        // A temporary atlas, built on its own thread
+        struct SubAtlas
+        {
+            std::vector<FontSourcesGroup> groups;
+            double estimatedCost = 0.;
+            std::unique_ptr<ImFontAtlas> atlas;
+            bool built = false;
+            // Position inside the final texture
+            int x = 0, y = 0;
+        };
+
+
+        // While the temporary atlases are created, built and destroyed, there is no current ImGui context,
+        // so that ImGui::MemAlloc/MemFree do not update the context debug allocation counters from several threads.
+        struct ScopedNoImGuiContext
+        {
+            ImGuiContext* previousContext;
+            ScopedNoImGuiContext() : previousContext(ImGui::GetCurrentContext()) { ImGui::SetCurrentContext(nullptr); }
+            ~ScopedNoImGuiContext() { ImGui::SetCurrentContext(previousContext); }
+        };
+
+
+        double EstimateRasterizationCost(ImFontAtlas* atlas, const ImFontConfig& cfg)
+        {
+            const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+            double nbGlyphs = 0.;
+            for (; ranges[0] && ranges[1]; ranges += 2)
+                nbGlyphs += (double)(ranges[1] - ranges[0] + 1);
+            return nbGlyphs * cfg.SizePixels * cfg.SizePixels * cfg.OversampleH * cfg.OversampleV;
+        }
+
+        std::vector<FontSourcesGroup> GatherFontSourcesGroups(ImFontAtlas* atlas)
+        {
+            std::vector<FontSourcesGroup> groups;
+            for (int i = 0; i < atlas->Sources.Size; ++i)
+            {
+                const ImFontConfig& cfg = atlas->Sources[i];
+                if (groups.empty() || groups.back().dstFont != cfg.DstFont)
+                {
+                    FontSourcesGroup group;
+                    group.dstFont = cfg.DstFont;
+                    group.firstSource = i;
+                    groups.push_back(group);
+                }
+                groups.back().nbSources++;
+                groups.back().estimatedCost += EstimateRasterizationCost(atlas, cfg);
+            }
+            return groups;
+        }
+
+        // Distributes the groups between the sub atlases (the most expensive group goes to the least loaded sub atlas)
+        std::vector<SubAtlas> DistributeGroups(std::vector<FontSourcesGroup> groups, int nbSubAtlases)
+        {
+            std::sort(groups.begin(), groups.end(),
+                [](const FontSourcesGroup& a, const FontSourcesGroup& b) { return a.estimatedCost > b.estimatedCost; });
+            std::vector<SubAtlas> subAtlases(nbSubAtlases);
+            for (const auto& group : groups)
+            {
+                auto leastLoaded = std::min_element(subAtlases.begin(), subAtlases.end(),
+                    [](const SubAtlas& a, const SubAtlas& b) { return a.estimatedCost < b.estimatedCost; });
+                leastLoaded->groups.push_back(group);
+                leastLoaded->estimatedCost += group.estimatedCost;
+            }
+            return subAtlases;
+        }
+
+        void CreateSubAtlas(ImFontAtlas* atlas, SubAtlas& subAtlas, bool withDefaultCustomRects)
+        {
+            subAtlas.atlas = std::make_unique<ImFontAtlas>();
+            ImFontAtlas* sub = subAtlas.atlas.get();
+            sub->Flags = atlas->Flags | ImFontAtlasFlags_NoPowerOfTwoHeight;
+            // Only one sub atlas holds the mouse cursors and the baked lines
+            if (!withDefaultCustomRects)
+                sub->Flags |= ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_NoBakedLines;
+            sub->TexDesiredWidth = atlas->TexDesiredWidth;
+            sub->TexGlyphPadding = atlas->TexGlyphPadding;
+            sub->FontBuilderIO = atlas->FontBuilderIO;
+            sub->FontBuilderFlags = atlas->FontBuilderFlags;
+
+            for (const auto& group : subAtlas.groups)
+            {
+                for (int i = 0; i < group.nbSources; ++i)
+                {
+                    ImFontConfig cfg = atlas->Sources[group.firstSource + i];
+                    cfg.DstFont = nullptr;
+                    cfg.MergeMode = (i > 0);
+                    // Share the font data with the main atlas (instead of letting AddFont copy it);
+                    // ownership is given back before the sub atlas is destroyed
+                    cfg.FontDataOwnedByAtlas = true;
+                    sub->AddFont(&cfg);
+                }
+            }
+        }
+
+        void ReleaseSubAtlasFontData(SubAtlas& subAtlas)
+        {
+            for (auto& cfg : subAtlas.atlas->Sources)
+                cfg.FontDataOwnedByAtlas = false;
+        }
+
+        // Places the sub atlas textures on shelves, and returns the final texture size
+        ImVec2 PackSubAtlases(std::vector<SubAtlas*>& subAtlases, int padding, bool powerOfTwoHeight)
+        {
+            std::sort(subAtlases.begin(), subAtlases.end(),
+                [](const SubAtlas* a, const SubAtlas* b) { return a->atlas->TexHeight > b->atlas->TexHeight; });
+
+            int width = 0;
+            double area = 0.;
+            for (auto subAtlas : subAtlases)
+            {
+                width = std::max(width, subAtlas->atlas->TexWidth);
+                area += (double)(subAtlas->atlas->TexWidth + padding) * (double)(subAtlas->atlas->TexHeight + padding);
+            }
+            while ((double)width * (double)width < area)
+                width *= 2;
+
+            int x = 0, y = 0, shelfHeight = 0;
+            for (auto subAtlas : subAtlases)
+            {
+                if (x + subAtlas->atlas->TexWidth > width)
+                {
+                    x = 0;
+                    y += shelfHeight + padding;
+                    shelfHeight = 0;
+                }
+                subAtlas->x = x;
+                subAtlas->y = y;
+                x += subAtlas->atlas->TexWidth + padding;
+                shelfHeight = std::max(shelfHeight, subAtlas->atlas->TexHeight);
+            }
+            int height = y + shelfHeight;
+            if (powerOfTwoHeight)
+                height = ImUpperPowerOfTwo(height);
+            return ImVec2((float)width, (float)height);
+        }
+
+        void CopySubAtlasIntoAtlas(ImFontAtlas* atlas, const SubAtlas& subAtlas, bool withDefaultCustomRects)
+        {
+            const ImFontAtlas* sub = subAtlas.atlas.get();
+            auto remapUv = [atlas, sub, &subAtlas](ImVec2 uv) {
+                return ImVec2(
+                    (uv.x * (float)sub->TexWidth + (float)subAtlas.x) * atlas->TexUvScale.x,
+                    (uv.y * (float)sub->TexHeight + (float)subAtlas.y) * atlas->TexUvScale.y);
+            };
+
+            for (int row = 0; row < sub->TexHeight; ++row)
+                memcpy(atlas->TexPixelsAlpha8 + (size_t)(subAtlas.y + row) * atlas->TexWidth + subAtlas.x,
+                       sub->TexPixelsAlpha8 + (size_t)row * sub->TexWidth,
+                       (size_t)sub->TexWidth);
+
+            // Fonts: the ImFont objects of the main atlas are kept (user code holds pointers to them)
+            for (size_t i = 0; i < subAtlas.groups.size(); ++i)
+            {
+                const FontSourcesGroup& group = subAtlas.groups[i];
+                const ImFont* srcFont = sub->Fonts[(int)i];
+                ImFont* dstFont = group.dstFont;
+                *dstFont = *srcFont;
+                dstFont->ContainerAtlas = atlas;
+                dstFont->Sources = &atlas->Sources[group.firstSource];
+                dstFont->SourcesCount = (short)group.nbSources;
+                if (srcFont->FallbackGlyph != nullptr)
+                    dstFont->FallbackGlyph = dstFont->Glyphs.Data + (srcFont->FallbackGlyph - srcFont->Glyphs.Data);
+                for (auto& glyph : dstFont->Glyphs)
+                {
+                    ImVec2 uv0 = remapUv(ImVec2(glyph.U0, glyph.V0)), uv1 = remapUv(ImVec2(glyph.U1, glyph.V1));
+                    glyph.U0 = uv0.x; glyph.V0 = uv0.y;
+                    glyph.U1 = uv1.x; glyph.V1 = uv1.y;
+                }
+            }
+
+            if (withDefaultCustomRects)
+            {
+                atlas->CustomRects = sub->CustomRects;
+                for (auto& rect : atlas->CustomRects)
+                {
+                    rect.X = (unsigned short)(rect.X + subAtlas.x);
+                    rect.Y = (unsigned short)(rect.Y + subAtlas.y);
+                }
+                atlas->PackIdMouseCursors = sub->PackIdMouseCursors;
+                atlas->PackIdLines = sub->PackIdLines;
+                atlas->TexUvWhitePixel = remapUv(sub->TexUvWhitePixel);
+                for (int i = 0; i < IM_ARRAYSIZE(atlas->TexUvLines); ++i)
+                {
+                    ImVec2 uv0 = remapUv(ImVec2(sub->TexUvLines[i].x, sub->TexUvLines[i].y));
+                    ImVec2 uv1 = remapUv(ImVec2(sub->TexUvLines[i].z, sub->TexUvLines[i].w));
+                    atlas->TexUvLines[i] = ImVec4(uv0.x, uv0.y, uv1.x, uv1.y);
+                }
+            }
+        }
+    } // anonymous namespace
+
+
+    bool BuildFontAtlasInParallel(ImFontAtlas* atlas)
+    {
+        IM_ASSERT(!atlas->Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+        if (atlas->TexReady)
+            return true;
+
+#ifdef IMMAPP_FONT_ATLAS_NO_THREADS
+        return atlas->Build();
+#else
+        std::vector<FontSourcesGroup> groups = GatherFontSourcesGroups(atlas);
+        int nbThreads = (int)std::min((size_t)std::thread::hardware_concurrency(), groups.size());
+        bool hasUserCustomRects = atlas->CustomRects.Size > 0;
+        if (nbThreads < 2 || hasUserCustomRects)
+            return atlas->Build();
+
+        std::vector<SubAtlas> subAtlases = DistributeGroups(groups, nbThreads);
+        bool allBuilt = true;
+        {
+            ScopedNoImGuiContext noImGuiContext;
+            for (size_t i = 0; i < subAtlases.size(); ++i)
+                CreateSubAtlas(atlas, subAtlases[i], i == 0);
+
+            std::vector<std::thread> threads;
+            for (auto& subAtlas : subAtlases)
+                threads.emplace_back([&subAtlas]() { subAtlas.built = subAtlas.atlas->Build(); });
+            for (auto& thread : threads)
+                thread.join();
+
+            for (const auto& subAtlas : subAtlases)
+            {
+                // Colored fonts are rendered directly to RGBA32: let ImGui handle them
+                bool isAlpha8 = subAtlas.atlas->TexPixelsAlpha8 != nullptr && !subAtlas.atlas->TexPixelsUseColors;
+                allBuilt = allBuilt && subAtlas.built && isAlpha8;
+            }
+        }
+
+        if (allBuilt)
+        {
+            std::vector<SubAtlas*> packOrder;
+            for (auto& subAtlas : subAtlases)
+                packOrder.push_back(&subAtlas);
+            bool powerOfTwoHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) == 0;
+            ImVec2 textureSize = PackSubAtlases(packOrder, atlas->TexGlyphPadding, powerOfTwoHeight);
+
+            atlas->ClearTexData();
+            atlas->TexWidth = (int)textureSize.x;
+            atlas->TexHeight = (int)textureSize.y;
+            atlas->TexUvScale = ImVec2(1.0f / (float)atlas->TexWidth, 1.0f / (float)atlas->TexHeight);
+            size_t nbPixels = (size_t)atlas->TexWidth * (size_t)atlas->TexHeight;
+            atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(nbPixels);
+            memset(atlas->TexPixelsAlpha8, 0, nbPixels);
+            for (size_t i = 0; i < subAtlases.size(); ++i)
+                CopySubAtlasIntoAtlas(atlas, subAtlases[i], i == 0);
+            atlas->TexPixelsUseColors = false;
+            atlas->TexReady = true;
+        }
+
+        {
+            ScopedNoImGuiContext noImGuiContext;
+            for (auto& subAtlas : subAtlases)
+            {
+                ReleaseSubAtlasFontData(subAtlas);
+                subAtlas.atlas.reset();
+            }
+        }
+
+        if (!allBuilt)
+            return atlas->Build();
+        return true;
+#endif
+    }
+} // namespace ImmApp
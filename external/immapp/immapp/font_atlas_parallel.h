@@ -0,0 +1,17 @@
+#pragma once
+
+struct ImFontAtlas;
+
+
+namespace ImmApp
+{
+    // BuildFontAtlasInParallel: builds a font atlas like ImFontAtlas::Build(), but rasterizes the fonts
+    // on several threads. The fonts are split into groups (a font and the fonts merged into it stay together),
+    // each group is rasterized into a temporary atlas on its own thread, and the temporary textures
+    // are then packed into the final atlas.
+    //
+    // Falls back to ImFontAtlas::Build() when it cannot help (single font, custom rects added by the user,
+    // colored fonts, or no thread support).
+    // Returns the same value as ImFontAtlas::Build().
+    bool BuildFontAtlasInParallel(ImFontAtlas* atlas);
+} // namespace ImmApp
@@ -0,0 +1,300 @@
+#include "immapp/frame_pacing.h"
+#include "immapp/clock.h"
+#include "immapp/runner.h"
+#include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/internal/functional_utils.h"
+
+#ifdef HELLOIMGUI_USE_GLFW3
+#include <GLFW/glfw3.h>
+#endif
+#ifdef HELLOIMGUI_USE_SDL2
+#include "SDL.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        enum class WakeUpBackend { None, Glfw, Sdl };
+
+        // Set once the app window exists (the wake-up functions of Glfw and Sdl are thread-safe)
+        std::atomic<WakeUpBackend> gWakeUpBackend { WakeUpBackend::None };
+
+        struct AnimationLease
+        {
+            ImGuiID leaseId;
+            double untilTime;
+            float fps;
+        };
+        // A few leases at most: a vector is enough
+        std::mutex gLeasesMutex;
+        std::vector<AnimationLease> gLeases;
+
+        void WakeUpMainLoop()
+        {
+            switch (gWakeUpBackend.load())
+            {
+#ifdef HELLOIMGUI_USE_GLFW3
+                case WakeUpBackend::Glfw:
+                    glfwPostEmptyEvent();
+                    break;
+#endif
+#ifdef HELLOIMGUI_USE_SDL2
+                case WakeUpBackend::Sdl:
+                {
+                    SDL_Event event = {};
+                    event.type = SDL_USEREVENT;
+                    SDL_PushEvent(&event);
+                    break;
+                }
+#endif
+                default:
+                    break;
+            }
+        }
+
+        // Returns false if the platform backend cannot wait for events
+        bool WaitForEventTimeout(double timeoutSeconds)
+        {
+            IM_UNUSED(timeoutSeconds); // when no platform backend can wait
+            switch (gWakeUpBackend.load())
+            {
+#ifdef HELLOIMGUI_USE_GLFW3
+                case WakeUpBackend::Glfw:
+                    glfwWaitEventsTimeout(timeoutSeconds);
+                    return true;
+#endif
+#ifdef HELLOIMGUI_USE_SDL2
+                case WakeUpBackend::Sdl:
+                    // With a null event, SDL leaves the event in the queue (HelloImGui will poll it)
+                    SDL_WaitEventTimeout(nullptr, (int)(timeoutSeconds * 1000.));
+                    return true;
+#endif
+                default:
+                    return false;
+            }
+        }
+
+        void DetectWakeUpBackend()
+        {
+            const HelloImGui::BackendPointers& backendPointers = HelloImGui::GetRunnerParams()->backendPointers;
+            if (backendPointers.glfwWindow != nullptr)
+                gWakeUpBackend = WakeUpBackend::Glfw;
+            else if (backendPointers.sdlWindow != nullptr)
+                gWakeUpBackend = WakeUpBackend::Sdl;
+            else
+                gWakeUpBackend = WakeUpBackend::None;
+        }
+
+        void ApplyAdaptiveIdling(float fpsIdleWithoutLease)
+        {
+            float requiredFps = RequiredAnimationFps();
+            HelloImGui::FpsIdling& fpsIdling = HelloImGui::GetRunnerParams()->fpsIdling;
+            // Note: for HelloImGui, fpsIdle = 0 means "maximum refresh speed"
+            fpsIdling.fpsIdle = requiredFps >= 0.f ? requiredFps : fpsIdleWithoutLease;
+        }
+
+        // Unchanged frames
+        UnchangedFramesStats gUnchangedFramesStats;
+        ImU64 gLastFrameHash = 0;
+        bool gHasLastFrameHash = false;
+
+        // A fast, non-cryptographic hash, which reads 8 bytes at a time
+        struct Hasher
+        {
+            ImU64 h = 0xcbf29ce484222325ULL;
+
+            void AddWord(ImU64 word)
+            {
+                h = (h ^ word) * 0x9E3779B97F4A7C15ULL;
+                h ^= h >> 29;
+            }
+            void AddBytes(const void* data, size_t size)
+            {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    ImU64 word;
+                    memcpy(&word, bytes + i, 8);
+                    AddWord(word);
+                }
+                if (i < size)
+                {
+                    ImU64 word = 0;
+                    memcpy(&word, bytes + i, size - i);
+                    AddWord(word);
+                }
+                AddWord((ImU64)size);
+            }
+            template<typename T> void Add(const T& value) { AddBytes(&value, sizeof(T)); }
+        };
+
+        void HashDrawDataInto(Hasher& hasher, const ImDrawData* drawData)
+        {
+            hasher.Add(drawData->DisplayPos);
+            hasher.Add(drawData->DisplaySize);
+            hasher.Add(drawData->FramebufferScale);
+            for (int n = 0; n < drawData->CmdListsCount; ++n)
+            {
+                const ImDrawList* drawList = drawData->CmdLists[n];
+                hasher.AddBytes(drawList->VtxBuffer.Data, (size_t)drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+                hasher.AddBytes(drawList->IdxBuffer.Data, (size_t)drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+                for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+                {
+                    // Not the whole struct: it may contain padding
+                    hasher.Add(cmd.ClipRect);
+                    hasher.Add(cmd.GetTexID());
+                    hasher.Add(cmd.VtxOffset);
+                    hasher.Add(cmd.IdxOffset);
+                    hasher.Add(cmd.ElemCount);
+                    hasher.Add(cmd.UserCallback);
+                }
+            }
+        }
+
+        // Called after each frame (AfterSwap): the draw data of all the viewports is still valid
+        void OnFrameRendered()
+        {
+            Hasher hasher;
+            for (ImGuiViewport* viewport : ImGui::GetPlatformIO().Viewports)
+                if (viewport->DrawData != nullptr)
+                    HashDrawDataInto(hasher, viewport->DrawData);
+
+            ++gUnchangedFramesStats.nbFrames;
+            bool isUnchanged = gHasLastFrameHash && (hasher.h == gLastFrameHash);
+            gLastFrameHash = hasher.h;
+            gHasLastFrameHash = true;
+            if (!isUnchanged)
+                return;
+            ++gUnchangedFramesStats.nbUnchangedFrames;
+
+            const HelloImGui::FpsIdling& fpsIdling = HelloImGui::GetRunnerParams()->fpsIdling;
+            if (fpsIdling.isIdling)
+                return; // HelloImGui already waits between frames
+            float fps = RequiredAnimationFps();
+            if (fps < 0.f)
+                fps = fpsIdling.fpsIdle;
+            if (fps <= 0.f)
+                return; // Maximum refresh speed was requested
+            if (WaitForEventTimeout(1. / fps))
+                ++gUnchangedFramesStats.nbThrottledFrames;
+        }
+    } // anonymous namespace
+
+
+    void RequestRedraw()
+    {
+        WakeUpMainLoop();
+    }
+
+    void AnimateUntil(ImGuiID leaseId, double untilTime, float fps)
+    {
+        bool isNewLease;
+        {
+            std::lock_guard<std::mutex> lock(gLeasesMutex);
+            auto it = std::find_if(gLeases.begin(), gLeases.end(),
+                                   [leaseId](const AnimationLease& lease) { return lease.leaseId == leaseId; });
+            isNewLease = (it == gLeases.end());
+            if (isNewLease)
+                gLeases.push_back({leaseId, untilTime, fps});
+            else
+                *it = {leaseId, untilTime, fps};
+        }
+        // A renewed lease is already being animated: only wake up the main loop for new leases
+        if (isNewLease)
+            WakeUpMainLoop();
+    }
+
+    void AnimateFor(ImGuiID leaseId, double duration, float fps)
+    {
+        AnimateUntil(leaseId, ClockSeconds() + duration, fps);
+    }
+
+    void EndAnimation(ImGuiID leaseId)
+    {
+        std::lock_guard<std::mutex> lock(gLeasesMutex);
+        gLeases.erase(
+            std::remove_if(gLeases.begin(), gLeases.end(),
+                           [leaseId](const AnimationLease& lease) { return lease.leaseId == leaseId; }),
+            gLeases.end());
+    }
+
+    float RequiredAnimationFps()
+    {
+        double now = ClockSeconds();
+        std::lock_guard<std::mutex> lock(gLeasesMutex);
+        gLeases.erase(
+            std::remove_if(gLeases.begin(), gLeases.end(),
+                           [now](const AnimationLease& lease) { return lease.untilTime <= now; }),
+            gLeases.end());
+        if (gLeases.empty())
+            return -1.f;
+
+        // The lowest fps which satisfies all the leases
+        float requiredFps = 0.f;
+        for (const AnimationLease& lease : gLeases)
+        {
+            if (lease.fps <= 0.f)
+                return 0.f;
+            requiredFps = std::max(requiredFps, lease.fps);
+        }
+        return requiredFps;
+    }
+
+
+    UnchangedFramesStats GetUnchangedFramesStats()
+    {
+        return gUnchangedFramesStats;
+    }
+
+    ImU64 HashDrawData(const ImDrawData* drawData)
+    {
+        Hasher hasher;
+        if (drawData != nullptr)
+            HashDrawDataInto(hasher, drawData);
+        return hasher.h;
+    }
+
+
+    // Called by the runner (see runner.cpp)
+    void Priv_SetupFramePacing(HelloImGui::RunnerParams& runnerParams, const AddOnsParams& addOnsParams)
+    {
+        runnerParams.callbacks.PostInit = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.PostInit,
+            DetectWakeUpBackend);
+        runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
+            [] { gWakeUpBackend = WakeUpBackend::None; },
+            runnerParams.callbacks.BeforeExit);
+
+        if (addOnsParams.withAdaptiveIdling)
+        {
+            float fpsIdleWithoutLease = addOnsParams.fpsIdleWithoutLease;
+            runnerParams.callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.PreNewFrame,
+                [fpsIdleWithoutLease] { ApplyAdaptiveIdling(fpsIdleWithoutLease); });
+        }
+
+        // Hashing the draw data of each frame has a cost: only when the unchanged frames are throttled
+        gUnchangedFramesStats = UnchangedFramesStats();
+        gHasLastFrameHash = false;
+        if (addOnsParams.throttleUnchangedFrames)
+            runnerParams.callbacks.AfterSwap = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.AfterSwap,
+                [] { OnFrameRendered(); });
+    }
+
+    void Priv_TearDownFramePacing()
+    {
+        gWakeUpBackend = WakeUpBackend::None;
+        std::lock_guard<std::mutex> lock(gLeasesMutex);
+        gLeases.clear();
+    }
+} // namespace ImmApp
@@ -0,0 +1,52 @@
+#pragma once
+#include "imgui.h"
+
+
+namespace ImmApp
+{
+    // Frame pacing: lets data dashboards idle at ~0% CPU, while still displaying new data within one frame.
+    //
+    // - RequestRedraw() can be called from any thread (e.g. by a background data producer):
+    //   if the main loop is idling, it is woken up, and one new frame is rendered.
+    //   (with the Glfw and Sdl platform backends. With FpsIdlingMode::EarlyReturn, e.g. under emscripten,
+    //   the new frame is rendered at the next idle frame)
+    // - AnimateUntil() takes an animation "lease": until its end, the app is rendered at least at the given fps.
+    //   Leases are identified by an ImGuiID, so that a widget can renew its own lease at each frame.
+    // - When AddOnsParams::withAdaptiveIdling is true, runnerParams.fpsIdling.fpsIdle is updated at each frame:
+    //   it is the lowest fps which satisfies all the active leases (or AddOnsParams::fpsIdleWithoutLease
+    //   when there are none).
+
+    // Wakes up the main loop, so that a new frame is rendered (thread-safe)
+    void RequestRedraw();
+
+    // Requests frames at least at `fps` (0: maximum refresh speed) until ClockSeconds() reaches untilTime.
+    // Calling it again with the same leaseId replaces the lease (thread-safe)
+    void AnimateUntil(ImGuiID leaseId, double untilTime, float fps = 0.f);
+    // Same as AnimateUntil(leaseId, ClockSeconds() + duration, fps)
+    void AnimateFor(ImGuiID leaseId, double duration, float fps = 0.f);
+    // Ends a lease before its end time
+    void EndAnimation(ImGuiID leaseId);
+
+    // The fps required by the active leases (-1 if there are none, 0 for the maximum refresh speed)
+    float RequiredAnimationFps();
+
+
+    // Unchanged frames: many frames produce the same draw data as the previous frame (cursor parked,
+    // nothing animating). When AddOnsParams::throttleUnchangedFrames is true, ImmApp hashes the draw data
+    // of each frame, and counts those frames: after an unchanged frame, the main loop waits for an event
+    // (user input, RequestRedraw(), ...) during at most 1 / fpsIdle seconds (or 1 / RequiredAnimationFps()),
+    // instead of rendering the next frame immediately. Otherwise, the stats stay at zero.
+    struct UnchangedFramesStats
+    {
+        // Number of rendered frames
+        int nbFrames = 0;
+        // Number of frames whose draw data was identical to the previous frame's
+        int nbUnchangedFrames = 0;
+        // Number of unchanged frames after which the main loop waited for an event
+        int nbThrottledFrames = 0;
+    };
+    UnchangedFramesStats GetUnchangedFramesStats();
+
+    // Hash of the draw data (vertices, indices, commands and display rect)
+    ImU64 HashDrawData(const ImDrawData* drawData);
+} // namespace ImmApp
@@ -0,0 +1,166 @@
+#ifdef HELLOIMGUI_WITH_TEST_ENGINE
+#include "immapp/headless_tests.h"
+#include "immapp/clock.h"
+#include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/internal/functional_utils.h"
+
+#include "imgui_test_engine/imgui_te_engine.h"
+#include "imgui_test_engine/imgui_te_internal.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        struct HeadlessTestsState
+        {
+            std::vector<ImGuiTest*> selectedTests;
+            bool testsQueued = false;
+            int nbFailed = 0;
+        };
+
+        // A wrong shard would silently run no tests (or the tests of another shard), and report a success
+        void CheckShardParams(const HeadlessTestsParams& params)
+        {
+            if (params.shardCount < 1 || params.shardIndex < 0 || params.shardIndex >= params.shardCount)
+                throw std::invalid_argument(
+                    "RunTestsHeadless: invalid shard " + std::to_string(params.shardIndex) + "/" + std::to_string(params.shardCount)
+                    + " (expected shardCount >= 1 and 0 <= shardIndex < shardCount)");
+        }
+
+        // Parses an environment variable which must be an integer
+        int IntFromEnvironment(const char* name, int defaultValue)
+        {
+            const char* value = std::getenv(name);
+            if (value == nullptr)
+                return defaultValue;
+            char* end = nullptr;
+            long parsed = std::strtol(value, &end, 10);
+            if (end == value || *end != '\0' || parsed < INT_MIN || parsed > INT_MAX)
+                throw std::invalid_argument(std::string("RunTestsHeadless: ") + name + "=\"" + value + "\" is not an integer");
+            return (int)parsed;
+        }
+
+        std::vector<ImGuiTest*> SelectShardTests(ImGuiTestEngine* engine, const HeadlessTestsParams& params)
+        {
+            std::vector<ImGuiTest*> tests;
+            for (int i = 0; i < engine->TestsAll.Size; ++i)
+                if (i % params.shardCount == params.shardIndex)
+                    tests.push_back(engine->TestsAll[i]);
+            return tests;
+        }
+
+        void ConfigureAndQueueTests(HeadlessTestsState& state, const HeadlessTestsParams& params)
+        {
+            ImGuiTestEngine* engine = HelloImGui::GetImGuiTestEngine();
+            ImGuiTestEngineIO& testIo = ImGuiTestEngine_GetIO(engine);
+            testIo.ConfigRunSpeed = ImGuiTestRunSpeed_Fast;
+            testIo.ConfigNoThrottle = true;
+            testIo.ConfigFixedDeltaTime = params.fixedDeltaTime;
+            testIo.ConfigSavedSettings = false;
+            testIo.ConfigLogToTTY = true;
+
+            state.selectedTests = SelectShardTests(engine, params);
+            for (ImGuiTest* test : state.selectedTests)
+                ImGuiTestEngine_QueueTest(engine, test);
+            state.testsQueued = true;
+        }
+
+        void ExitWhenTestsAreDone(const HeadlessTestsState& state)
+        {
+            if (!state.testsQueued)
+                return;
+            ImGuiTestEngine* engine = HelloImGui::GetImGuiTestEngine();
+            if (ImGuiTestEngine_IsTestQueueEmpty(engine) && !ImGuiTestEngine_GetIO(engine).IsRunningTests)
+                HelloImGui::GetRunnerParams()->appShallExit = true;
+        }
+
+        // Collects the results (a test may also have ended the app, e.g. by clicking an "Exit" button)
+        void CollectResults(HeadlessTestsState& state, const HeadlessTestsParams& params)
+        {
+            FILE* resultsFile = nullptr;
+            if (!params.resultsFile.empty())
+            {
+                resultsFile = fopen(params.resultsFile.c_str(), "w");
+                if (resultsFile == nullptr)
+                    fprintf(stderr, "RunTestsHeadless: cannot write %s\n", params.resultsFile.c_str());
+            }
+
+            state.nbFailed = 0;
+            for (ImGuiTest* test : state.selectedTests)
+            {
+                bool success = (test->Output.Status == ImGuiTestStatus_Success);
+                if (!success)
+                    ++state.nbFailed;
+                if (resultsFile != nullptr)
+                    fprintf(resultsFile, "%s %s/%s\n", success ? "success" : "error", test->Category, test->Name);
+            }
+            if (resultsFile != nullptr)
+                fclose(resultsFile);
+
+            printf("RunTestsHeadless: shard %d/%d: %d tests, %d failed\n",
+                   params.shardIndex, params.shardCount, (int)state.selectedTests.size(), state.nbFailed);
+        }
+    } // anonymous namespace
+
+
+    HeadlessTestsParams HeadlessTestsParamsFromEnvironment()
+    {
+        HeadlessTestsParams params;
+        params.shardIndex = IntFromEnvironment("IMMAPP_TEST_SHARD_INDEX", params.shardIndex);
+        params.shardCount = IntFromEnvironment("IMMAPP_TEST_SHARD_COUNT", params.shardCount);
+        CheckShardParams(params);
+        if (const char* resultsFile = std::getenv("IMMAPP_TEST_RESULTS_FILE"))
+            params.resultsFile = resultsFile;
+        return params;
+    }
+
+    int RunTestsHeadless(
+        HelloImGui::RunnerParams& runnerParams,
+        const HeadlessTestsParams& testsParams,
+        const AddOnsParams& addOnsParams)
+    {
+        CheckShardParams(testsParams);
+
+        runnerParams.platformBackendType = HelloImGui::PlatformBackendType::Null;
+        runnerParams.rendererBackendType = HelloImGui::RendererBackendType::Null;
+        runnerParams.useImGuiTestEngine = true;
+        runnerParams.fpsIdling.enableIdling = false;
+        runnerParams.fpsIdling.rememberEnableIdling = false;
+
+        // Each shard starts from fresh settings, in its own ini file (shards run concurrently)
+        runnerParams.iniFilename_useAppWindowTitle = false;
+        runnerParams.iniFilename = "imgui_headless_tests_shard_" + std::to_string(testsParams.shardIndex) + ".ini";
+        {
+            std::error_code ec;
+            std::filesystem::remove(HelloImGui::IniSettingsLocation(runnerParams), ec);
+        }
+
+        auto state = std::make_shared<HeadlessTestsState>();
+        runnerParams.callbacks.RegisterTests = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.RegisterTests,
+            [state, testsParams] { ConfigureAndQueueTests(*state, testsParams); });
+        runnerParams.callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.PreNewFrame,
+            [state] { ExitWhenTestsAreDone(*state); });
+        runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
+            [state, testsParams] { CollectResults(*state, testsParams); },
+            runnerParams.callbacks.BeforeExit);
+
+        SetClockUsesImGuiTime(true);
+        Run(runnerParams, addOnsParams);
+        SetClockUsesImGuiTime(false);
+
+        return state->nbFailed;
+    }
+} // namespace ImmApp
+
+#endif // #ifdef HELLOIMGUI_WITH_TEST_ENGINE
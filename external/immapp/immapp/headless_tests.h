@@ -0,0 +1,43 @@
+#pragma once
+#ifdef HELLOIMGUI_WITH_TEST_ENGINE
+#include "immapp/runner.h"
+
+#include <string>
+
+
+namespace ImmApp
+{
+    // HeadlessTestsParams: run the registered imgui_test_engine tests headless, as fast as the CPU allows.
+    // - the Null platform and renderer backends are used; idling and throttling are disabled
+    // - the time is virtual: each frame advances ImGui::GetTime() and ImmApp::ClockSeconds() by fixedDeltaTime,
+    //   so that the test duration depends on the CPU, not on the animations' wall-clock time
+    // - the tests can be sharded between several processes (see shardIndex / shardCount)
+    struct HeadlessTestsParams
+    {
+        // Virtual duration of a frame, in seconds
+        float fixedDeltaTime = 1.f / 60.f;
+
+        // This process only runs the tests whose registration index % shardCount == shardIndex
+        int shardIndex = 0;
+        int shardCount = 1;
+
+        // If not empty, the results are written to this file, one line per test: "success|error category/name"
+        // (see .github/ci_automation_tests/run_sharded_tests.py, which launches the shards and merges their results)
+        std::string resultsFile;
+    };
+
+    // Reads the shard and the results file from the environment variables
+    // IMMAPP_TEST_SHARD_INDEX, IMMAPP_TEST_SHARD_COUNT and IMMAPP_TEST_RESULTS_FILE (when they are set).
+    // Throws std::invalid_argument if the shard is not made of integers with 0 <= shardIndex < shardCount.
+    HeadlessTestsParams HeadlessTestsParamsFromEnvironment();
+
+    // Runs the tests registered in runnerParams.callbacks.RegisterTests (for this shard), and exits when they are done.
+    // Returns the number of failed tests.
+    // Throws std::invalid_argument if the shard is invalid (it would otherwise silently run no tests).
+    int RunTestsHeadless(
+        HelloImGui::RunnerParams& runnerParams,
+        const HeadlessTestsParams& testsParams = HeadlessTestsParams(),
+        const AddOnsParams& addOnsParams = AddOnsParams());
+} // namespace ImmApp
+
+#endif // #ifdef HELLOIMGUI_WITH_TEST_ENGINE
@@ -1,3 +1,8 @@
 #pragma once
 #include "immapp/runner.h"
 #include "immapp/clock.h"
+#include "immapp/asset_cache.h"
+#include "immapp/frame_pacing.h"
+#include "immapp/settings_journal.h"
+#include "immapp/texture_readback.h"
+#include "immapp/headless_tests.h"
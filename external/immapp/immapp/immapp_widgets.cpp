@@ -1,5 +1,6 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "immapp/immapp_widgets.h"
+#include "immapp/software_renderer.h"
 #include "hello_imgui/hello_imgui.h"
 #ifdef IMGUI_BUNDLE_WITH_IMPLOT
 #include "implot/implot.h"
@@ -9,6 +10,10 @@
 #include "imgui-node-editor/imgui_node_editor.h"
 #include "imgui-node-editor/imgui_node_editor_internal.h"
 #endif
+#include "imgui_internal.h"
+
+#include <climits>
+#include <unordered_map>
 
 namespace ImmApp
 {
@@ -24,15 +29,276 @@ namespace ImmApp
 #endif // #if defined(IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR)
 
 #if defined(IMGUI_BUNDLE_WITH_IMPLOT) && defined(IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR)
+    static PlotInNodeEditorParams gPlotInNodeEditorParams;
+    PlotInNodeEditorParams& GetPlotInNodeEditorParams() { return gPlotInNodeEditorParams; }
+
+    // PlotDrawSnapshot: a low resolution image of a plot, displayed instead of plotting live when the node editor
+    // is zoomed out. The plot is rasterized once (on the CPU) at the on-screen resolution of the zoom threshold,
+    // and the image is stored as rectangles of uniform color (runs of equal pixels, merged across rows):
+    // the cost of displaying it depends on this resolution, not on the number of plotted points.
+    struct PlotDrawSnapshot
+    {
+        struct Rect
+        {
+            ImU16 X0, Y0, X1, Y1;       // in snapshot pixels (X1 and Y1 are exclusive)
+            ImU32 Col;
+        };
+        ImVector<Rect> Rects;
+        float Resolution = 1.f;         // snapshot pixels per canvas pixel
+        ImVec2 PlotSize;
+        // ImGui frame counts: last frame where the plot was submitted, and where it was plotted live near the zoom threshold
+        int LastUsedFrame = 0;
+        int LastNearThresholdFrame = -1;
+    };
+
+    // PlotDrawCapture: state between BeginPlotInNodeEditor and EndPlotInNodeEditor, when capturing a snapshot
+    struct PlotDrawCapture
+    {
+        bool Active = false;
+        ImGuiID Id = 0;
+        ImDrawList* DrawList = nullptr;
+        ImVec2 Origin;
+        ImVec2 PlotSize;
+        float Resolution = 1.f;
+        int IdxStart = 0;
+    };
+
+    static std::unordered_map<ImGuiID, PlotDrawSnapshot> gPlotDrawSnapshots;
+    static PlotDrawCapture gPlotDrawCapture;
+    static int gPlotDrawSnapshotsLastPruneFrame = -1;
+
+    // Snapshots of plots which were not submitted during this many frames are discarded (removed plots or editors)
+    static constexpr int kPlotDrawSnapshotMaxUnusedFrames = 600;
+
+    static void PrunePlotDrawSnapshots(int frame)
+    {
+        if (frame == gPlotDrawSnapshotsLastPruneFrame)
+            return;
+        gPlotDrawSnapshotsLastPruneFrame = frame;
+        for (auto it = gPlotDrawSnapshots.begin(); it != gPlotDrawSnapshots.end();)
+        {
+            if (frame - it->second.LastUsedFrame > kPlotDrawSnapshotMaxUnusedFrames)
+                it = gPlotDrawSnapshots.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    // Keeps at most maxSnapshots snapshots, by discarding the least recently used ones
+    static void LimitPlotDrawSnapshotsCount(int maxSnapshots)
+    {
+        while ((int)gPlotDrawSnapshots.size() > ImMax(maxSnapshots, 0))
+        {
+            auto oldest = gPlotDrawSnapshots.begin();
+            for (auto it = gPlotDrawSnapshots.begin(); it != gPlotDrawSnapshots.end(); ++it)
+                if (it->second.LastUsedFrame < oldest->second.LastUsedFrame)
+                    oldest = it;
+            gPlotDrawSnapshots.erase(oldest);
+        }
+    }
+
+    // Copies the draw commands emitted by the plot into drawList
+    static void CopyPlotDrawCommands(const PlotDrawCapture& capture, ImDrawList* drawList)
+    {
+        const ImDrawList* dl = capture.DrawList;
+        for (const ImDrawCmd& drawCmd : dl->CmdBuffer)
+        {
+            // Only keep the part of the commands emitted by the plot
+            int idxBegin = ImMax((int)drawCmd.IdxOffset, capture.IdxStart);
+            int idxEnd = (int)(drawCmd.IdxOffset + drawCmd.ElemCount);
+            if (idxEnd <= idxBegin || drawCmd.UserCallback != nullptr)
+                continue;
+
+            int vtxMin = INT_MAX, vtxMax = -1;
+            for (int i = idxBegin; i < idxEnd; ++i)
+            {
+                int v = (int)drawCmd.VtxOffset + (int)dl->IdxBuffer[i];
+                vtxMin = ImMin(vtxMin, v);
+                vtxMax = ImMax(vtxMax, v);
+            }
+
+            ImDrawCmd cmd;
+            cmd.ClipRect = drawCmd.ClipRect;
+            cmd.TextureId = drawCmd.TextureId;
+            cmd.VtxOffset = (unsigned int)drawList->VtxBuffer.Size;
+            cmd.IdxOffset = (unsigned int)drawList->IdxBuffer.Size;
+            cmd.ElemCount = (unsigned int)(idxEnd - idxBegin);
+            for (int v = vtxMin; v <= vtxMax; ++v)
+                drawList->VtxBuffer.push_back(dl->VtxBuffer[v]);
+            for (int i = idxBegin; i < idxEnd; ++i)
+                drawList->IdxBuffer.push_back((ImDrawIdx)((int)drawCmd.VtxOffset + (int)dl->IdxBuffer[i] - vtxMin));
+            drawList->CmdBuffer.push_back(cmd);
+        }
+    }
+
+    static void CapturePlotDrawSnapshot(const PlotDrawCapture& capture)
+    {
+        ImDrawList drawList(ImGui::GetDrawListSharedData());
+        CopyPlotDrawCommands(capture, &drawList);
+        ImDrawData drawData;
+        drawData.Valid = true;
+        drawData.AddDrawList(&drawList);
+        drawData.DisplayPos = capture.Origin;
+        drawData.DisplaySize = capture.PlotSize;
+        drawData.FramebufferScale = ImVec2(capture.Resolution, capture.Resolution);
+
+        SoftwareRendererParams rendererParams;
+        rendererParams.nbThreads = 1;
+        rendererParams.clearColor = ImVec4(0.f, 0.f, 0.f, 0.f);
+        SoftwareImage image;
+        SoftwareRenderDrawData(&drawData, &image, rendererParams);
+
+        PlotDrawSnapshot snapshot;
+        snapshot.Resolution = capture.Resolution;
+        // Rects which end at the previous row, by (X0, X1, Col): they are extended if the current row has the same run
+        std::unordered_map<ImU64, int> openRects, rowRects;
+        const ImU32* pixels = reinterpret_cast<const ImU32*>(image.pixels.data());
+        for (int y = 0; y < image.height; ++y)
+        {
+            const ImU32* row = pixels + (size_t)y * image.width;
+            rowRects.clear();
+            for (int x0 = 0; x0 < image.width;)
+            {
+                int x1 = x0 + 1;
+                while (x1 < image.width && row[x1] == row[x0])
+                    ++x1;
+                ImU32 col = row[x0];
+                ImU32 alpha = col >> IM_COL32_A_SHIFT;
+                if (alpha > 0)
+                {
+                    if (alpha < 255)
+                    {
+                        // The image was rendered over a transparent background: its colors are premultiplied
+                        ImU32 r = ImMin(255u, ((col >> IM_COL32_R_SHIFT) & 0xFF) * 255 / alpha);
+                        ImU32 g = ImMin(255u, ((col >> IM_COL32_G_SHIFT) & 0xFF) * 255 / alpha);
+                        ImU32 b = ImMin(255u, ((col >> IM_COL32_B_SHIFT) & 0xFF) * 255 / alpha);
+                        col = IM_COL32(r, g, b, alpha);
+                    }
+                    ImU64 key = (ImU64)x0 | ((ImU64)x1 << 16) | ((ImU64)col << 32);
+                    auto open = openRects.find(key);
+                    if (open != openRects.end())
+                    {
+                        snapshot.Rects[open->second].Y1 = (ImU16)(y + 1);
+                        rowRects[key] = open->second;
+                    }
+                    else
+                    {
+                        snapshot.Rects.push_back(PlotDrawSnapshot::Rect{ (ImU16)x0, (ImU16)y, (ImU16)x1, (ImU16)(y + 1), col });
+                        rowRects[key] = snapshot.Rects.Size - 1;
+                    }
+                }
+                x0 = x1;
+            }
+            std::swap(openRects, rowRects);
+        }
+
+        snapshot.PlotSize = capture.PlotSize;
+        snapshot.LastUsedFrame = ImGui::GetFrameCount();
+        snapshot.LastNearThresholdFrame = ImGui::GetFrameCount();
+        gPlotDrawSnapshots[capture.Id] = std::move(snapshot);
+    }
+
+    static void DrawPlotDrawSnapshot(const PlotDrawSnapshot& snapshot, ImVec2 origin)
+    {
+        ImDrawList* dl = ImGui::GetWindowDrawList();
+        // The rects are drawn with the white pixel of the font atlas
+        dl->PushTextureID(ImGui::GetIO().Fonts->TexID);
+        float k = 1.f / snapshot.Resolution;
+        // Reserve by chunks, so that 16 bits indices do not overflow
+        constexpr int kRectsPerChunk = 8192;
+        for (int chunkStart = 0; chunkStart < snapshot.Rects.Size; chunkStart += kRectsPerChunk)
+        {
+            int chunkEnd = ImMin(chunkStart + kRectsPerChunk, snapshot.Rects.Size);
+            dl->PrimReserve((chunkEnd - chunkStart) * 6, (chunkEnd - chunkStart) * 4);
+            for (int i = chunkStart; i < chunkEnd; ++i)
+            {
+                const PlotDrawSnapshot::Rect& rect = snapshot.Rects[i];
+                dl->PrimRect(
+                    ImVec2(origin.x + (float)rect.X0 * k, origin.y + (float)rect.Y0 * k),
+                    ImVec2(origin.x + (float)rect.X1 * k, origin.y + (float)rect.Y1 * k),
+                    rect.Col);
+            }
+        }
+        dl->PopTextureID();
+    }
+
+    // Number of screen pixels per canvas pixel in the current node editor
+    static float NodeEditorOnScreenScale()
+    {
+        return ed::CanvasToScreen(ImVec2(1.f, 0.f)).x - ed::CanvasToScreen(ImVec2(0.f, 0.f)).x;
+    }
+
     bool BeginPlotInNodeEditor(const char* title_id, const ImVec2& size, ImPlotFlags flags)
     {
+        const PlotInNodeEditorParams& params = gPlotInNodeEditorParams;
+        ImVec2 plotSize = ImGui::CalcItemSize(size, ImPlot::GetStyle().PlotDefaultSize.x, ImPlot::GetStyle().PlotDefaultSize.y);
+        ImVec2 plotOrigin = ImGui::GetCursorScreenPos();
+        ImGuiID plotId = ImGui::GetID(title_id);
+
+        int frame = ImGui::GetFrameCount();
+        PrunePlotDrawSnapshots(frame);
+        auto snapshotIt = gPlotDrawSnapshots.find(plotId);
+        PlotDrawSnapshot* snapshot = snapshotIt != gPlotDrawSnapshots.end() ? &snapshotIt->second : nullptr;
+        if (snapshot != nullptr && (snapshot->PlotSize != plotSize || snapshot->Resolution != params.snapshotZoomThreshold))
+        {
+            gPlotDrawSnapshots.erase(snapshotIt); // Resized plot, or changed threshold
+            snapshot = nullptr;
+        }
+        bool wasNearThreshold = false;
+        if (snapshot != nullptr)
+        {
+            snapshot->LastUsedFrame = frame;
+            wasNearThreshold = (snapshot->LastNearThresholdFrame == frame - 1);
+        }
+
+        // Offscreen node: only reserve the plot size
+        if (params.cullOffscreenPlots && !ImGui::IsRectVisible(plotOrigin, plotOrigin + plotSize))
+        {
+            ImGui::Dummy(plotSize);
+            return false;
+        }
+
+        // Zoomed out: display the cached snapshot, if available
+        float onScreenScale = NodeEditorOnScreenScale();
+        bool useSnapshot = onScreenScale < params.snapshotZoomThreshold;
+        if (useSnapshot && snapshot != nullptr)
+        {
+            DrawPlotDrawSnapshot(*snapshot, plotOrigin);
+            ImGui::Dummy(plotSize);
+            return false;
+        }
+
+        int idxStartBeforeBeginPlot = ImGui::GetWindowDrawList()->IdxBuffer.Size;
         ImPlot::GetCurrentContext()->CanDragPlotInNodeEditor = true;
-        return ImPlot::BeginPlot(title_id, size, flags);
+        bool visible = ImPlot::BeginPlot(title_id, size, flags);
+
+        // Capture a snapshot once when the zoom comes close to the threshold (or if there is no snapshot yet
+        // while zoomed out), instead of copying the plot geometry at each frame
+        bool isNearThreshold = onScreenScale < params.snapshotZoomThreshold * 2.f;
+        if (snapshot != nullptr && isNearThreshold)
+            snapshot->LastNearThresholdFrame = frame;
+        gPlotDrawCapture.Active = visible && isNearThreshold && (snapshot == nullptr || !wasNearThreshold);
+        if (gPlotDrawCapture.Active)
+        {
+            gPlotDrawCapture.Id = plotId;
+            gPlotDrawCapture.DrawList = ImGui::GetWindowDrawList();
+            gPlotDrawCapture.Origin = plotOrigin;
+            gPlotDrawCapture.PlotSize = plotSize;
+            gPlotDrawCapture.Resolution = params.snapshotZoomThreshold;
+            gPlotDrawCapture.IdxStart = idxStartBeforeBeginPlot;
+        }
+        return visible;
     }
 
     void EndPlotInNodeEditor()
     {
         ImPlot::EndPlot();
+        if (gPlotDrawCapture.Active)
+        {
+            CapturePlotDrawSnapshot(gPlotDrawCapture);
+            LimitPlotDrawSnapshotsCount(gPlotInNodeEditorParams.maxSnapshots);
+            gPlotDrawCapture.Active = false;
+        }
         if (ImGui::IsMouseHoveringRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax()))
             DisableUserInputInNodeEditor();
     }
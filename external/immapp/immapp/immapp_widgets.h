@@ -16,8 +16,28 @@ namespace ImmApp
     using VoidFunction = std::function<void(void)>;
 
 #ifdef IMGUI_BUNDLE_WITH_IMPLOT_AND_IMGUI_NODE_EDITOR
+    // PlotInNodeEditorParams: tune how plots inside a node editor are culled
+    // (applies to BeginPlotInNodeEditor and ShowResizablePlotInNodeEditor)
+    struct PlotInNodeEditorParams
+    {
+        // If true, plots that are outside the visible region of the node editor are not plotted:
+        // only their size is reserved
+        bool cullOffscreenPlots = true;
+        // When the node editor is zoomed out so that the plot is displayed at less than this scale
+        // (on screen pixels per canvas pixel), a cached snapshot of the plot is displayed instead
+        // of plotting it live. Set to 0 to always plot live.
+        // The snapshot is a low resolution image (rasterized at this scale), taken once,
+        // when the zoom goes below twice this scale.
+        float snapshotZoomThreshold = 0.5f;
+        // Maximum number of cached snapshots (the least recently displayed plots are discarded first)
+        int maxSnapshots = 512;
+    };
+    PlotInNodeEditorParams& GetPlotInNodeEditorParams();
+
     // These functions wrap ImPlot::BeginPlot and ImPlot::EndPlot,
-    // but they enable to make the plot content draggable inside a node
+    // but they enable to make the plot content draggable inside a node.
+    // BeginPlotInNodeEditor returns false (and only reserves the plot size) if the plot is culled
+    // (see PlotInNodeEditorParams): in this case, do not call EndPlotInNodeEditor.
     bool BeginPlotInNodeEditor(const char* title_id, const ImVec2& size=ImVec2(-1,0), ImPlotFlags flags=0);
     void EndPlotInNodeEditor();
 
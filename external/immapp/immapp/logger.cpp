@@ -0,0 +1,290 @@
+#include "immapp/logger.h"
+#include "immapp/clock.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        using HelloImGui::LogLevel;
+
+        LogParams gLogParams;
+        std::atomic<bool> gLogRingAllocated{false};
+
+
+        struct LogSlot
+        {
+            // 0: never written, 2 * ticket + 1: message #ticket is being written, 2 * ticket + 2: message #ticket is ready
+            std::atomic<uint64_t> sequence{0};
+            LogLevel level = LogLevel::Info;
+            double time = 0.;
+            int length = 0;
+        };
+
+        enum class LogReadResult { Ok, NotReady, Overwritten };
+
+
+        // A bounded multi-producer ring buffer:
+        // - each producer reserves a ticket with an atomic increment, and writes its message into the slot
+        //   (ticket % capacity), whose text storage is preallocated. The oldest messages are overwritten.
+        // - the reader checks the slot sequence before and after copying a message (seqlock), so that
+        //   a message overwritten while being read is detected.
+        class LogRing
+        {
+        public:
+            explicit LogRing(const LogParams& params)
+            {
+                mCapacity = 1;
+                while (mCapacity < (uint64_t)std::max(params.capacity, 1))
+                    mCapacity *= 2;
+                mMaxMessageLength = (size_t)std::max(params.maxMessageLength, 16);
+                mSlots.reset(new LogSlot[mCapacity]);
+                mArena.reset(new char[mCapacity * mMaxMessageLength]);
+            }
+
+            void Push(LogLevel level, const char* format, va_list args)
+            {
+                uint64_t ticket = mHead.fetch_add(1, std::memory_order_relaxed);
+                LogSlot& slot = mSlots[ticket & (mCapacity - 1)];
+                slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                char* text = SlotText(ticket);
+                int length = vsnprintf(text, mMaxMessageLength, format, args);
+                if (length < 0)
+                {
+                    text[0] = '\0';
+                    length = 0;
+                }
+                slot.length = std::min(length, (int)mMaxMessageLength - 1);
+                slot.level = level;
+                slot.time = ClockSeconds();
+                slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+            }
+
+            // Copies message #ticket into outText (whose size must be at least MaxMessageLength())
+            LogReadResult Read(uint64_t ticket, LogLevel* outLevel, double* outTime, char* outText) const
+            {
+                const LogSlot& slot = mSlots[ticket & (mCapacity - 1)];
+                uint64_t expected = 2 * ticket + 2;
+                uint64_t before = slot.sequence.load(std::memory_order_acquire);
+                if (before < expected)
+                    return LogReadResult::NotReady;
+                if (before > expected)
+                    return LogReadResult::Overwritten;
+
+                int length = std::clamp(slot.length, 0, (int)mMaxMessageLength - 1);
+                *outLevel = slot.level;
+                *outTime = slot.time;
+                memcpy(outText, SlotText(ticket), (size_t)length);
+                outText[length] = '\0';
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+                return (after == expected) ? LogReadResult::Ok : LogReadResult::Overwritten;
+            }
+
+            void Clear() { mClearedBefore.store(mHead.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+            uint64_t Head() const { return mHead.load(std::memory_order_acquire); }
+            // Tickets older than this were overwritten or cleared
+            uint64_t FirstRetainedTicket() const
+            {
+                uint64_t head = Head();
+                uint64_t firstInRing = (head > mCapacity) ? head - mCapacity : 0;
+                return std::max(firstInRing, mClearedBefore.load(std::memory_order_relaxed));
+            }
+            size_t MaxMessageLength() const { return mMaxMessageLength; }
+
+        private:
+            char* SlotText(uint64_t ticket) const { return mArena.get() + (ticket & (mCapacity - 1)) * mMaxMessageLength; }
+
+            uint64_t mCapacity = 0;
+            size_t mMaxMessageLength = 0;
+            std::unique_ptr<LogSlot[]> mSlots;
+            std::unique_ptr<char[]> mArena;
+            std::atomic<uint64_t> mHead{0};
+            std::atomic<uint64_t> mClearedBefore{0};
+        };
+
+        LogRing& GetLogRing()
+        {
+            // Intentionally leaked: other threads may still log during static destruction
+            static LogRing* ring = new LogRing(gLogParams);
+            gLogRingAllocated = true;
+            return *ring;
+        }
+
+
+        // LogGui state: only accessed from the main thread
+        struct LogGuiState
+        {
+            bool showLevels[4] = {true, true, true, true};
+            char searchBuffer[256] = "";
+            bool autoScroll = true;
+
+            // Filters used to build visibleTickets
+            bool appliedShowLevels[4] = {true, true, true, true};
+            std::string appliedSearch;
+
+            // Next message to examine, and messages which pass the filters
+            uint64_t nextTicket = 0;
+            std::deque<uint64_t> visibleTickets;
+            std::vector<char> textBuffer;
+        };
+        LogGuiState gLogGuiState;
+
+
+        bool MessagePassesFilters(const LogGuiState& state, LogLevel level, const char* text)
+        {
+            if (!state.appliedShowLevels[(int)level])
+                return false;
+            if (state.appliedSearch.empty())
+                return true;
+            const char* search = state.appliedSearch.c_str();
+            return ImStristr(text, nullptr, search, search + state.appliedSearch.size()) != nullptr;
+        }
+
+        // Updates visibleTickets: only the new messages are examined, except when the filters changed
+        void UpdateVisibleTickets(LogGuiState& state, const LogRing& ring)
+        {
+            state.textBuffer.resize(ring.MaxMessageLength());
+            char* text = state.textBuffer.data();
+            LogLevel level;
+            double time;
+
+            bool levelsChanged = memcmp(state.showLevels, state.appliedShowLevels, sizeof(state.showLevels)) != 0;
+            std::string search = state.searchBuffer;
+            if (levelsChanged || search != state.appliedSearch)
+            {
+                // When the search text was only extended, the visible messages are a subset of the current ones
+                bool isRefinement = !levelsChanged && search.compare(0, state.appliedSearch.size(), state.appliedSearch) == 0;
+                memcpy(state.appliedShowLevels, state.showLevels, sizeof(state.showLevels));
+                state.appliedSearch = search;
+                if (isRefinement)
+                {
+                    std::deque<uint64_t> refined;
+                    for (uint64_t ticket : state.visibleTickets)
+                        if (ring.Read(ticket, &level, &time, text) == LogReadResult::Ok && MessagePassesFilters(state, level, text))
+                            refined.push_back(ticket);
+                    state.visibleTickets.swap(refined);
+                }
+                else
+                {
+                    state.visibleTickets.clear();
+                    state.nextTicket = 0;
+                }
+            }
+
+            uint64_t firstRetained = ring.FirstRetainedTicket();
+            while (!state.visibleTickets.empty() && state.visibleTickets.front() < firstRetained)
+                state.visibleTickets.pop_front();
+            state.nextTicket = std::max(state.nextTicket, firstRetained);
+
+            uint64_t head = ring.Head();
+            for (; state.nextTicket < head; ++state.nextTicket)
+            {
+                LogReadResult result = ring.Read(state.nextTicket, &level, &time, text);
+                if (result == LogReadResult::NotReady)
+                    break; // still being written: we will come back to it next frame
+                if (result == LogReadResult::Ok && MessagePassesFilters(state, level, text))
+                    state.visibleTickets.push_back(state.nextTicket);
+            }
+        }
+
+        ImVec4 LogLevelColor(LogLevel level)
+        {
+            switch (level)
+            {
+                case LogLevel::Debug: return ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled);
+                case LogLevel::Warning: return ImVec4(1.f, 0.85f, 0.3f, 1.f);
+                case LogLevel::Error: return ImVec4(1.f, 0.35f, 0.35f, 1.f);
+                default: return ImGui::GetStyleColorVec4(ImGuiCol_Text);
+            }
+        }
+    } // anonymous namespace
+
+
+    void SetLogParams(const LogParams& params)
+    {
+        IM_ASSERT(!gLogRingAllocated && "ImmApp::SetLogParams must be called before the first call to ImmApp::Log");
+        gLogParams = params;
+    }
+
+    void Log(HelloImGui::LogLevel level, char const* const format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        GetLogRing().Push(level, format, args);
+        va_end(args);
+    }
+
+    void LogClear()
+    {
+        GetLogRing().Clear();
+    }
+
+    void LogGui(ImVec2 size)
+    {
+        LogRing& ring = GetLogRing();
+        LogGuiState& state = gLogGuiState;
+
+        ImGui::PushID("ImmApp::LogGui");
+        const char* levelNames[4] = {"Debug", "Info", "Warning", "Error"};
+        for (int i = 0; i < 4; ++i)
+        {
+            ImGui::Checkbox(levelNames[i], &state.showLevels[i]);
+            ImGui::SameLine();
+        }
+        if (ImGui::Button("Clear"))
+            LogClear();
+        ImGui::SameLine();
+        ImGui::Checkbox("Auto-scroll", &state.autoScroll);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 12.f);
+        ImGui::InputTextWithHint("##search", "Search", state.searchBuffer, IM_ARRAYSIZE(state.searchBuffer));
+
+        UpdateVisibleTickets(state, ring);
+
+        ImGui::BeginChild("##log", size, ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+        char* text = state.textBuffer.data();
+        LogLevel level;
+        double time;
+        ImGuiListClipper clipper;
+        clipper.Begin((int)state.visibleTickets.size());
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                if (ring.Read(state.visibleTickets[(size_t)row], &level, &time, text) != LogReadResult::Ok)
+                {
+                    ImGui::TextDisabled("(overwritten)");
+                    continue;
+                }
+                ImGui::TextDisabled("[%9.3f]", time);
+                ImGui::SameLine();
+                ImGui::PushStyleColor(ImGuiCol_Text, LogLevelColor(level));
+                ImGui::TextUnformatted(text);
+                ImGui::PopStyleColor();
+            }
+        }
+        clipper.End();
+        if (state.autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+            ImGui::SetScrollHereY(1.0f);
+        ImGui::EndChild();
+        ImGui::PopID();
+    }
+} // namespace ImmApp
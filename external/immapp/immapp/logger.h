@@ -0,0 +1,27 @@
+#pragma once
+#include "hello_imgui/hello_imgui.h"
+
+
+namespace ImmApp
+{
+    // ImmApp::Log is an alternative to HelloImGui::Log, for applications which log a lot, from several threads:
+    // - Log() can be called from any thread. It is wait-free and does not allocate: messages are formatted
+    //   into a preallocated ring buffer (and truncated to LogParams::maxMessageLength).
+    // - Only the last LogParams::capacity messages are retained: older messages are overwritten.
+    // - LogGui() only renders the visible lines, with level filters and a search field:
+    //   its cost per frame does not depend on the number of retained messages.
+    //   LogGui() must be called from the main thread.
+    struct LogParams
+    {
+        // Number of retained messages (rounded up to a power of two)
+        int capacity = 65536;
+        // Maximum length of a message, in bytes (longer messages are truncated)
+        int maxMessageLength = 256;
+    };
+    // SetLogParams must be called before the first call to Log (the ring buffer is allocated on first use)
+    void SetLogParams(const LogParams& params);
+
+    void Log(HelloImGui::LogLevel level, char const* const format, ...);
+    void LogClear();
+    void LogGui(ImVec2 size=ImVec2(0.f, 0.f));
+} // namespace ImmApp
@@ -0,0 +1,142 @@
+#ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
+#include "immapp/settings_journal.h"
+#include "imgui-node-editor/imgui_node_editor.h"
+#include "imgui-node-editor/crude_json.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+
+// Node editor settings, when stored in the settings journal
+// ----------------------------------------------------------
+// Each node is stored under its own key ("node_editor/<node id>", via the per node callbacks of the node editor),
+// and the view state (selection, scroll, zoom) under "node_editor/view": moving a node appends only this node.
+//
+// Limitation: the node editor itself still serializes all its settings (including all the nodes) before calling
+// Config::SaveSettings. This callback only parses them when the view state changed.
+namespace ImmApp
+{
+    namespace
+    {
+        namespace ed = ax::NodeEditor;
+
+        const char* kViewKey = "node_editor/view";
+        std::string gNodeEditorSettingsFile; // Imported once into the journal
+
+        std::string NodeJournalKey(ed::NodeId nodeId)
+        {
+            return "node_editor/" + std::to_string(nodeId.Get());
+        }
+
+        // The node editor settings, without the nodes
+        std::string ViewState(crude_json::value settings)
+        {
+            if (!settings.is_object())
+                return "{}";
+            settings.get<crude_json::object>().erase("nodes");
+            return settings.dump();
+        }
+
+        // Imports once the settings stored as a whole: the .node_editor.json file, or the "node_editor" key
+        // of older journals. They are split into the view state and one key per node.
+        void ImportNodeEditorSettings(SettingsJournal* journal)
+        {
+            std::optional<std::string> settingsText = journal->Get("node_editor");
+            if (!settingsText.has_value())
+            {
+                std::ifstream is(gNodeEditorSettingsFile, std::ios::binary);
+                if (!gNodeEditorSettingsFile.empty() && is.good())
+                    settingsText = std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+            }
+
+            crude_json::value settings = crude_json::value::parse(settingsText.value_or("{}"));
+            if (settings.is_object() && settings.contains("nodes") && settings["nodes"].is_object())
+            {
+                // Nodes are serialized as "node:<id>"
+                for (const auto& [nodeKey, nodeSettings] : settings["nodes"].get<crude_json::object>())
+                    if (nodeKey.rfind("node:", 0) == 0)
+                        journal->Set("node_editor/" + nodeKey.substr(5), nodeSettings.dump());
+            }
+            journal->Set(kViewKey, ViewState(settings));
+            journal->Erase("node_editor");
+        }
+
+        // The node editor passes all its settings (including all the nodes): only the view state is stored here,
+        // and they are parsed only if it may have changed (the nodes are saved by SaveNodeSettings)
+        bool SaveSettings(const char* data, size_t size, ed::SaveReasonFlags reason, void*)
+        {
+            SettingsJournal* journal = GetSettingsJournal();
+            if (journal == nullptr)
+                return false;
+            const auto viewReasons = ed::SaveReasonFlags::Navigation | ed::SaveReasonFlags::Selection | ed::SaveReasonFlags::User;
+            if ((reason & viewReasons) == ed::SaveReasonFlags::None && journal->Has(kViewKey))
+                return true;
+            journal->Set(kViewKey, ViewState(crude_json::value::parse(std::string(data, size))));
+            return true;
+        }
+
+        // Called twice by the node editor: first with data=nullptr to query the size, then to copy the settings
+        size_t CopySettings(const std::optional<std::string>& settings, char* data)
+        {
+            if (!settings.has_value())
+                return 0;
+            if (data != nullptr)
+                memcpy(data, settings->data(), settings->size());
+            return settings->size();
+        }
+
+        size_t LoadSettings(char* data, void*)
+        {
+            SettingsJournal* journal = GetSettingsJournal();
+            if (journal == nullptr)
+                return 0;
+            if (!journal->Has(kViewKey))
+                ImportNodeEditorSettings(journal);
+            return CopySettings(journal->Get(kViewKey), data);
+        }
+
+        bool SaveNodeSettings(ed::NodeId nodeId, const char* data, size_t size, ed::SaveReasonFlags, void*)
+        {
+            SettingsJournal* journal = GetSettingsJournal();
+            if (journal == nullptr)
+                return false;
+            journal->Set(NodeJournalKey(nodeId), std::string(data, size));
+            return true;
+        }
+
+        size_t LoadNodeSettings(ed::NodeId nodeId, char* data, void*)
+        {
+            SettingsJournal* journal = GetSettingsJournal();
+            if (journal == nullptr)
+                return 0;
+            return CopySettings(journal->Get(NodeJournalKey(nodeId)), data);
+        }
+    } // anonymous namespace
+
+
+    // Called by the runner: stores the node editor settings in the journal (unless the user handles them)
+    void Priv_SetupNodeEditorJournal(ed::Config& config)
+    {
+        if (GetSettingsJournal() != nullptr
+            && config.SaveSettings == nullptr && config.LoadSettings == nullptr
+            && config.SaveNodeSettings == nullptr && config.LoadNodeSettings == nullptr)
+        {
+            gNodeEditorSettingsFile = config.SettingsFile;
+            config.SaveSettings = SaveSettings;
+            config.LoadSettings = LoadSettings;
+            config.SaveNodeSettings = SaveNodeSettings;
+            config.LoadNodeSettings = LoadNodeSettings;
+        }
+        else if (GetSettingsJournal() == nullptr && config.SaveSettings == SaveSettings)
+        {
+            // Set by a previous run (the config is kept between runs)
+            config.SaveSettings = nullptr;
+            config.LoadSettings = nullptr;
+            config.SaveNodeSettings = nullptr;
+            config.LoadNodeSettings = nullptr;
+        }
+    }
+} // namespace ImmApp
+
+#endif // #ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
@@ -1,4 +1,7 @@
 #include "immapp.h"
+#include "immapp/font_atlas_parallel.h"
+#include "immapp/software_renderer.h"
+#include "immapp/theme_cache.h"
 
 #ifdef IMGUI_BUNDLE_WITH_IMPLOT
 #include "implot/implot.h"
@@ -25,9 +28,13 @@ std::function<void()> FnResetImGuiNodeEditorId; // may be bound from pybind_imgu
 void UpdateNodeEditorColorsFromImguiColors();
 #endif
 
+#include <array>
 #include <chrono>
 #include <cassert>
+#include <cstring>
 #include <filesystem>
+#include <memory>
+#include <vector>
 
 
 // Private API used by ImGuiTexInspect (not mentioned in headers!)
@@ -55,9 +62,58 @@ namespace ImmApp
     // ---------------------------------------------------
     static int gRendererInstanceCount = 0;
     static AddOnsParams gAddOnsParamsAtSetup;
+    static StartupTimings gStartupTimings;
 
     static void Priv_TearDown();
 
+    // Implemented in software_renderer.cpp
+    void Priv_CaptureFinalSoftwareScreenshot(const ImVec4& clearColor);
+    void Priv_ResetFinalSoftwareScreenshot();
+    // Implemented in clock.cpp
+    void Priv_SetupFrameClock(HelloImGui::RunnerParams& runnerParams);
+    void Priv_TearDownFrameClock();
+    // Implemented in frame_pacing.cpp
+    void Priv_SetupFramePacing(HelloImGui::RunnerParams& runnerParams, const AddOnsParams& addOnsParams);
+    void Priv_TearDownFramePacing();
+    // Implemented in settings_journal.cpp
+    void Priv_SetupSettingsJournal(HelloImGui::RunnerParams& runnerParams, const AddOnsParams& addOnsParams);
+    void Priv_TearDownSettingsJournal();
+#ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
+    // Implemented in node_editor_journal.cpp
+    void Priv_SetupNodeEditorJournal(ax::NodeEditor::Config& config);
+#endif
+    // Implemented in texture_readback.cpp
+    void Priv_SetupTextureReadback(HelloImGui::RunnerParams& runnerParams);
+
+
+    // "On style changed" handlers
+    // ---------------------------
+    // Add-ons whose style is derived from the ImGui style register a handler here.
+    // Handlers are called once the ImGui style is set up, and afterward only when ImGui::GetStyle().Colors
+    // changes (the colors are compared once per frame, instead of each add-on recomputing its style every frame).
+    static std::vector<VoidFunction> gOnStyleChangedHandlers;
+    static std::array<ImVec4, ImGuiCol_COUNT> gLastStyleColors;
+    static bool gLastStyleColorsValid = false;
+
+    static void Priv_AddOnStyleChangedHandler(const VoidFunction& handler)
+    {
+        gOnStyleChangedHandlers.push_back(handler);
+    }
+
+    static void Priv_CallOnStyleChangedHandlersIfNeeded()
+    {
+        if (gOnStyleChangedHandlers.empty())
+            return;
+        const ImGuiStyle& style = ImGui::GetStyle();
+        if (gLastStyleColorsValid && memcmp(gLastStyleColors.data(), style.Colors, sizeof(style.Colors)) == 0)
+            return;
+        memcpy(gLastStyleColors.data(), style.Colors, sizeof(style.Colors));
+        gLastStyleColorsValid = true;
+        for (const auto& handler : gOnStyleChangedHandlers)
+            handler();
+    }
+
+
 
     static void Priv_Setup(HelloImGui::RunnerParams& runnerParams, const AddOnsParams& passedAddOnsParams)
     {
@@ -80,6 +136,67 @@ namespace ImmApp
 #endif
         gRendererInstanceCount++;
 
+        // Measure the time to first frame
+        {
+            gStartupTimings = StartupTimings();
+            double setupTime = ClockSeconds();
+            auto firstFrameDone = std::make_shared<bool>(false);
+            auto fnMeasureTimeToFirstFrame = [setupTime, firstFrameDone]
+            {
+                if (*firstFrameDone)
+                    return;
+                *firstFrameDone = true;
+                gStartupTimings.timeToFirstFrame = ClockSeconds() - setupTime;
+            };
+            runnerParams.callbacks.AfterSwap = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.AfterSwap,
+                fnMeasureTimeToFirstFrame);
+        }
+
+        // Without a GPU, the last frame is rendered on the CPU, so that FinalAppWindowSoftwareScreenshot() is available
+        Priv_ResetFinalSoftwareScreenshot();
+        if (runnerParams.rendererBackendType == HelloImGui::RendererBackendType::Null)
+        {
+            ImVec4 clearColor = runnerParams.imGuiWindowParams.backgroundColor;
+            runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
+                [clearColor] { Priv_CaptureFinalSoftwareScreenshot(clearColor); },
+                runnerParams.callbacks.BeforeExit);
+        }
+
+        // Frame clock, sampled before each frame
+        Priv_SetupFrameClock(runnerParams);
+
+        // RequestRedraw(), animation leases and unchanged frames
+        Priv_SetupFramePacing(runnerParams, addOnsParams);
+
+        // Asynchronous screenshots (OpenGL)
+        Priv_SetupTextureReadback(runnerParams);
+
+        // Journaled settings (before the add-ons which store their settings in the journal)
+        Priv_SetupSettingsJournal(runnerParams, addOnsParams);
+
+        // Start loading the assets while the window is being created
+        if (!addOnsParams.prefetchAssets.empty())
+            PrefetchAssets(addOnsParams.prefetchAssets);
+
+        // Call the "on style changed" handlers once at startup, and then on each frame where the style colors changed.
+        // We choose a relatively unused callback to avoid situations where a user would forget to chain the callbacks.
+        {
+            auto fnForceStyleChangedHandlers = []
+            {
+                gLastStyleColorsValid = false;
+                Priv_CallOnStyleChangedHandlersIfNeeded();
+            };
+            runnerParams.callbacks.SetupImGuiStyle = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.SetupImGuiStyle,
+                fnForceStyleChangedHandlers
+            );
+            runnerParams.callbacks.BeforeImGuiRender = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.BeforeImGuiRender,
+                Priv_CallOnStyleChangedHandlersIfNeeded
+            );
+        }
+
 
         // create implot context if required
 #ifdef IMGUI_BUNDLE_WITH_IMPLOT
@@ -105,6 +222,8 @@ namespace ImmApp
             {
                 gImmAppContext._NodeEditorConfig.SettingsFile = NodeEditorSettingsLocation(runnerParams);
             }
+            // Store the settings in the journal (unless the user handles them)
+            Priv_SetupNodeEditorJournal(gImmAppContext._NodeEditorConfig);
 
             gImmAppContext._NodeEditorContext = ax::NodeEditor::CreateEditor(&gImmAppContext._NodeEditorConfig);
             ax::NodeEditor::SetCurrentEditor(gImmAppContext._NodeEditorContext.value());
@@ -114,23 +233,9 @@ namespace ImmApp
                 runnerParams.callbacks.BeforeExit
             );
 
-            // Update node editor colors from imgui colors
-            auto fnUpdateNodeEditorColorsFromImguiColors = [&]
-            {
-                if (addOnsParams.updateNodeEditorColorsFromImguiColors)
-                    UpdateNodeEditorColorsFromImguiColors();
-            };
-            // Once at startup
-            runnerParams.callbacks.SetupImGuiStyle = HelloImGui::SequenceFunctions(
-                runnerParams.callbacks.SetupImGuiStyle,
-                fnUpdateNodeEditorColorsFromImguiColors
-            );
-            // Once every frame. We choose a relatively unused callback to avoid
-            // situations where a user would forget to chain the callbacks.
-            runnerParams.callbacks.BeforeImGuiRender = HelloImGui::SequenceFunctions(
-                runnerParams.callbacks.BeforeImGuiRender,
-                fnUpdateNodeEditorColorsFromImguiColors
-            );
+            // Update node editor colors from imgui colors (once at startup, and then when the ImGui colors change)
+            if (addOnsParams.updateNodeEditorColorsFromImguiColors)
+                Priv_AddOnStyleChangedHandler(UpdateNodeEditorColorsFromImguiColors);
         }
 #endif
 
@@ -146,8 +251,31 @@ namespace ImmApp
                 ImGuiMd::GetFontLoaderFunction());
         }
 
+        // Rasterize the fonts on several threads, once all of them were added
+        // (this must stay after the add-ons which load fonts)
+        if (addOnsParams.buildFontAtlasInParallel)
+        {
+            auto fnBuildFontAtlasInParallel = []
+            {
+                double startTime = ClockSeconds();
+                BuildFontAtlasInParallel(ImGui::GetIO().Fonts);
+                gStartupTimings.fontAtlasBuildDuration = ClockSeconds() - startTime;
+            };
+            runnerParams.callbacks.LoadAdditionalFonts = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.LoadAdditionalFonts,
+                fnBuildFontAtlasInParallel);
+        }
+
 #ifdef IMGUI_BUNDLE_WITH_IMFILEDIALOG
         ImFileDialogSetupTextureLoader();
+        // Upload pending thumbnails within a per-frame budget
+        runnerParams.callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.PreNewFrame,
+            ImFileDialogProcessPendingTextureUploads);
+        // Clear ImFileDialog thumbnail cache, before OpenGl is uninitialized
+        runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.BeforeExit,
+            ImFileDialogClearTextureCache);
 #endif
 
 #ifdef IMGUI_BUNDLE_WITH_TEXT_INSPECT
@@ -205,6 +333,11 @@ namespace ImmApp
         AddOnsParams& addOnsParams = gAddOnsParamsAtSetup;
 
         gRendererInstanceCount = 0;
+        gOnStyleChangedHandlers.clear();
+        gLastStyleColorsValid = false;
+        Priv_TearDownFramePacing();
+        Priv_TearDownFrameClock();
+        ClearThemeCache();
 
 #ifdef IMGUI_BUNDLE_WITH_IMPLOT
         if (addOnsParams.withImplot)
@@ -226,6 +359,9 @@ namespace ImmApp
 
         if (addOnsParams.withMarkdown || addOnsParams.withMarkdownOptions.has_value())
             ImGuiMd::DeInitializeMarkdown();
+
+        // After the node editor, which saves its settings when destroyed
+        Priv_TearDownSettingsJournal();
     }
 
     void Run(HelloImGui::RunnerParams& runnerParams, const AddOnsParams& addOnsParams)
@@ -328,6 +464,11 @@ namespace ImmApp
         Run(simpleRunnerParams, addOnsParams);
     }
 
+    StartupTimings GetStartupTimings()
+    {
+        return gStartupTimings;
+    }
+
     float EmSize()
     {
         return HelloImGui::EmSize();
@@ -50,7 +50,8 @@ namespace ImmApp
 
         // If true, the node editor colors will be updated from the ImGui colors
         // (i.e. if using a light theme, the node editor will use a light theme, etc.)
-        // This is called after runnerParams.callbacks.SetupImGuiStyle, in which you can set the ImGui style.
+        // This is called after runnerParams.callbacks.SetupImGuiStyle, in which you can set the ImGui style,
+        // and then again whenever the ImGui style colors change.
         // If you set this to false, you can set the node editor style manually.
         // (Note: you can also the theme via RunnerParams.imguiParams.tweakedTheme)
         bool updateNodeEditorColorsFromImguiColors = true;
@@ -58,6 +59,31 @@ namespace ImmApp
 
         // You can tweak MarkdownOptions (but this is optional)
         std::optional<ImGuiMd::MarkdownOptions> withMarkdownOptions = std::nullopt;
+
+        // Assets (fonts, images, ...) that will be loaded on worker threads while the window is being created.
+        // Use ImmApp::LoadAssetShared() to access them once loaded (HelloImGui's own loaders, such as LoadFont
+        // or ImageAndSizeFromAsset, read the files again).
+        std::vector<std::string> prefetchAssets = {};
+
+        // Set buildFontAtlasInParallel=true to rasterize the fonts on several threads at startup
+        // (useful when many fonts are loaded, e.g. with markdown, on slow devices).
+        // See GetStartupTimings() to measure its effect.
+        bool buildFontAtlasInParallel = false;
+
+        // Set withAdaptiveIdling=true to let ImmApp set runnerParams.fpsIdling.fpsIdle at each frame:
+        // it will be the lowest fps which satisfies all the animation leases (see AnimateUntil in frame_pacing.h),
+        // or fpsIdleWithoutLease when there are none. Use RequestRedraw() to display new data immediately.
+        bool withAdaptiveIdling = false;
+        float fpsIdleWithoutLease = 1.f;
+
+        // Set throttleUnchangedFrames=true to avoid rendering frames at full speed when their output does not change
+        // (see GetUnchangedFramesStats in frame_pacing.h)
+        bool throttleUnchangedFrames = false;
+
+        // Set withJournaledSettings=true to store the settings incrementally in a journal (see settings_journal.h):
+        // the node editor settings are appended to it when they change (instead of rewriting .node_editor.json),
+        // and the ImGui settings are restored after a crash.
+        bool withJournaledSettings = false;
     };
 
 
@@ -134,6 +160,24 @@ namespace ImmApp
     );
 
 
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Startup timings
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+    struct StartupTimings
+    {
+        // Time between the application setup (ImmApp::Run or ManualRender::SetupFromXXX)
+        // and the end of the first frame, in seconds
+        double timeToFirstFrame = 0.;
+        // Duration of the font atlas build, in seconds (only measured when AddOnsParams.buildFontAtlasInParallel
+        // is true: otherwise, the atlas is built by the renderer during the first frame)
+        double fontAtlasBuildDuration = 0.;
+    };
+    // Returns the timings measured during the last application startup
+    StartupTimings GetStartupTimings();
+
+
     /////////////////////////////////////////////////////////////////////////////////////////
     //
     // Dpi aware utilities (which call the same utilities from HelloImGui)
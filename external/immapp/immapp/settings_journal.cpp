@@ -0,0 +1,396 @@
+#include "immapp/settings_journal.h"
+#include "immapp/runner.h"
+#include "hello_imgui/internal/functional_utils.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        // The journal is compacted when it is larger than twice the live settings, plus this margin
+        constexpr size_t kCompactionMargin = 64 * 1024;
+
+        uint32_t Fnv1a(char op, const std::string& key, const std::string& value)
+        {
+            uint32_t h = 2166136261u;
+            auto add = [&h](const char* data, size_t size) {
+                for (size_t i = 0; i < size; ++i)
+                    h = (h ^ (unsigned char)data[i]) * 16777619u;
+            };
+            add(&op, 1);
+            add(key.data(), key.size());
+            add(value.data(), value.size());
+            return h;
+        }
+
+        // A record is "<op> <keyLength> <valueLength> <checksum>\n<key><value>\n"
+        // where op is 'S' (set) or 'E' (erase)
+        std::string MakeRecord(char op, const std::string& key, const std::string& value)
+        {
+            char header[64];
+            snprintf(header, sizeof(header), "%c %zu %zu %08" PRIx32 "\n",
+                     op, key.size(), value.size(), Fnv1a(op, key, value));
+            std::string record = header;
+            record.reserve(record.size() + key.size() + value.size() + 1);
+            record += key;
+            record += value;
+            record += '\n';
+            return record;
+        }
+
+        // Same as MakeRecord('S', key, value).size(), without copying the value
+        size_t RecordSize(const std::string& key, const std::string& value)
+        {
+            char header[64];
+            int headerSize = snprintf(header, sizeof(header), "S %zu %zu 00000000\n", key.size(), value.size());
+            return (size_t)headerSize + key.size() + value.size() + 1;
+        }
+
+        // Parses the records, and returns the size of the valid part of the journal:
+        // a record torn by a crash (or any corruption) ends the journal
+        size_t ParseJournal(const std::string& content, std::map<std::string, std::string>* settings)
+        {
+            size_t pos = 0;
+            while (pos < content.size())
+            {
+                size_t headerEnd = content.find('\n', pos);
+                if (headerEnd == std::string::npos)
+                    break;
+                char op = 0;
+                size_t keyLength = 0, valueLength = 0;
+                uint32_t checksum = 0;
+                std::string header = content.substr(pos, headerEnd - pos);
+                if (sscanf(header.c_str(), "%c %zu %zu %" SCNx32, &op, &keyLength, &valueLength, &checksum) != 4)
+                    break;
+                if (op != 'S' && op != 'E')
+                    break;
+                size_t dataStart = headerEnd + 1;
+                if (keyLength > content.size() - dataStart
+                    || valueLength > content.size() - dataStart - keyLength
+                    || dataStart + keyLength + valueLength >= content.size()
+                    || content[dataStart + keyLength + valueLength] != '\n')
+                    break;
+                std::string key = content.substr(dataStart, keyLength);
+                std::string value = content.substr(dataStart + keyLength, valueLength);
+                if (Fnv1a(op, key, value) != checksum)
+                    break;
+
+                if (op == 'S')
+                    (*settings)[key] = std::move(value);
+                else
+                    settings->erase(key);
+                pos = dataStart + keyLength + valueLength + 1;
+            }
+            return pos;
+        }
+
+        bool ReadFile(const std::string& filename, std::string* content)
+        {
+            std::ifstream is(filename, std::ios::binary);
+            if (!is.good())
+                return false;
+            std::stringstream ss;
+            ss << is.rdbuf();
+            *content = ss.str();
+            return true;
+        }
+    } // anonymous namespace
+
+
+    SettingsJournal::SettingsJournal(const std::string& filename)
+        : mFilename(filename)
+    {
+    }
+
+    SettingsJournal::~SettingsJournal()
+    {
+        // Do not wait for a compaction: the journal is already up to date
+        mCancelCompaction = true;
+        JoinCompactionThread();
+        if (mJournalFile != nullptr)
+            fclose(mJournalFile);
+    }
+
+    std::optional<std::string> SettingsJournal::Get(const std::string& key)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        LoadIfNeeded();
+        auto it = mSettings.find(key);
+        if (it == mSettings.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    bool SettingsJournal::Has(const std::string& key)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        LoadIfNeeded();
+        return mSettings.find(key) != mSettings.end();
+    }
+
+    void SettingsJournal::Set(const std::string& key, const std::string& value)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        LoadIfNeeded();
+        auto it = mSettings.find(key);
+        if (it != mSettings.end())
+        {
+            if (it->second == value)
+                return;
+            mLiveBytes -= RecordSize(key, it->second);
+            it->second = value;
+        }
+        else
+            mSettings[key] = value;
+        mLiveBytes += RecordSize(key, value);
+        AppendRecord('S', key, value);
+        CompactIfNeeded();
+    }
+
+    void SettingsJournal::Erase(const std::string& key)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        LoadIfNeeded();
+        auto it = mSettings.find(key);
+        if (it == mSettings.end())
+            return;
+        mLiveBytes -= RecordSize(key, it->second);
+        mSettings.erase(it);
+        AppendRecord('E', key, "");
+        CompactIfNeeded();
+    }
+
+    void SettingsJournal::Compact()
+    {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        LoadIfNeeded();
+        if (mIsCompacting)
+            return; // A background compaction is already running
+        std::string tmpFilename = mFilename + ".tmp";
+        mRecordsDuringCompaction.clear();
+        if (WriteCompactedJournal(mSettings, tmpFilename))
+            FinishCompaction(tmpFilename);
+    }
+
+    void SettingsJournal::LoadIfNeeded()
+    {
+        if (mIsLoaded)
+            return;
+        mIsLoaded = true;
+
+        std::string content;
+        if (ReadFile(mFilename, &content))
+        {
+            size_t validSize = ParseJournal(content, &mSettings);
+            if (validSize < content.size())
+            {
+                // Drop the torn tail, so that the next records are appended after a valid one
+                std::error_code ec;
+                std::filesystem::resize_file(mFilename, validSize, ec);
+            }
+            mJournalBytes = validSize;
+        }
+        for (const auto& kv : mSettings)
+            mLiveBytes += RecordSize(kv.first, kv.second);
+
+        mJournalFile = fopen(mFilename.c_str(), "ab");
+        if (mJournalFile == nullptr)
+            fprintf(stderr, "SettingsJournal: cannot open %s, the settings will not be saved\n", mFilename.c_str());
+    }
+
+    void SettingsJournal::AppendRecord(char op, const std::string& key, const std::string& value)
+    {
+        std::string record = MakeRecord(op, key, value);
+        if (mJournalFile != nullptr)
+        {
+            fwrite(record.data(), 1, record.size(), mJournalFile);
+            fflush(mJournalFile);
+        }
+        mJournalBytes += record.size();
+        if (mIsCompacting)
+            mRecordsDuringCompaction += record;
+    }
+
+    void SettingsJournal::CompactIfNeeded()
+    {
+        if (mIsCompacting || mJournalFile == nullptr)
+            return;
+        if (mJournalBytes <= 2 * mLiveBytes + kCompactionMargin)
+            return;
+
+        // The previous compaction thread (if any) has finished, since mIsCompacting is false
+        if (mCompactionThread.joinable())
+            mCompactionThread.join();
+        mIsCompacting = true;
+        mRecordsDuringCompaction.clear();
+        mCompactionThread = std::thread([this, snapshot = mSettings]() {
+            std::string tmpFilename = mFilename + ".tmp";
+            bool success = WriteCompactedJournal(snapshot, tmpFilename);
+            std::lock_guard<std::recursive_mutex> lock(mMutex);
+            if (success && !mCancelCompaction)
+                FinishCompaction(tmpFilename);
+            else
+            {
+                std::error_code ec;
+                std::filesystem::remove(tmpFilename, ec);
+            }
+            mIsCompacting = false;
+            mRecordsDuringCompaction.clear();
+        });
+    }
+
+    bool SettingsJournal::WriteCompactedJournal(const std::map<std::string, std::string>& settings, const std::string& tmpFilename)
+    {
+        FILE* f = fopen(tmpFilename.c_str(), "wb");
+        if (f == nullptr)
+            return false;
+        bool success = true;
+        for (const auto& kv : settings)
+        {
+            if (mCancelCompaction)
+            {
+                success = false;
+                break;
+            }
+            std::string record = MakeRecord('S', kv.first, kv.second);
+            if (fwrite(record.data(), 1, record.size(), f) != record.size())
+            {
+                success = false;
+                break;
+            }
+        }
+        if (fclose(f) != 0)
+            success = false;
+        return success;
+    }
+
+    // Called with mMutex locked: appends the records written during the compaction, and replaces the journal
+    void SettingsJournal::FinishCompaction(const std::string& tmpFilename)
+    {
+        FILE* f = fopen(tmpFilename.c_str(), "ab");
+        if (f == nullptr)
+            return;
+        size_t written = fwrite(mRecordsDuringCompaction.data(), 1, mRecordsDuringCompaction.size(), f);
+        if (fclose(f) != 0 || written != mRecordsDuringCompaction.size())
+        {
+            std::error_code ec;
+            std::filesystem::remove(tmpFilename, ec);
+            return;
+        }
+
+        if (mJournalFile != nullptr)
+            fclose(mJournalFile);
+        mJournalFile = nullptr;
+        std::error_code ec;
+        std::filesystem::rename(tmpFilename, mFilename, ec);
+        if (ec)
+            std::filesystem::remove(tmpFilename, ec);
+        else
+            mJournalBytes = (size_t)std::filesystem::file_size(mFilename, ec);
+        mJournalFile = fopen(mFilename.c_str(), "ab");
+    }
+
+    void SettingsJournal::JoinCompactionThread()
+    {
+        if (mCompactionThread.joinable())
+            mCompactionThread.join();
+    }
+
+
+    // Journaled settings of the app
+    // -----------------------------
+    namespace
+    {
+        std::unique_ptr<SettingsJournal> gSettingsJournal;
+        bool gImGuiIniRestored = false;
+
+        // ImGui sets WantSaveIniSettings when its settings were modified (HelloImGui saves them only at exit)
+        void JournalImGuiIniIfNeeded()
+        {
+            if (!gImGuiIniRestored)
+            {
+                // The journal still contains the ImGui settings if the previous run did not exit normally
+                gImGuiIniRestored = true;
+                std::optional<std::string> iniSettings = gSettingsJournal->Get("imgui.ini");
+                if (iniSettings.has_value())
+                    ImGui::LoadIniSettingsFromMemory(iniSettings->c_str(), iniSettings->size());
+            }
+
+            ImGuiIO& io = ImGui::GetIO();
+            if (!io.WantSaveIniSettings)
+                return;
+            size_t iniSize = 0;
+            const char* iniData = ImGui::SaveIniSettingsToMemory(&iniSize);
+            gSettingsJournal->Set("imgui.ini", std::string(iniData, iniSize));
+            io.WantSaveIniSettings = false;
+        }
+    } // anonymous namespace
+
+    SettingsJournal* GetSettingsJournal()
+    {
+        return gSettingsJournal.get();
+    }
+
+    void SaveUserPrefToJournal(const std::string& userPrefName, const std::string& userPrefContent)
+    {
+        if (gSettingsJournal == nullptr)
+        {
+            HelloImGui::SaveUserPref(userPrefName, userPrefContent);
+            return;
+        }
+        gSettingsJournal->Set("user_pref/" + userPrefName, userPrefContent);
+    }
+
+    std::string LoadUserPrefFromJournal(const std::string& userPrefName)
+    {
+        if (gSettingsJournal != nullptr)
+        {
+            std::optional<std::string> userPref = gSettingsJournal->Get("user_pref/" + userPrefName);
+            if (userPref.has_value())
+                return *userPref;
+        }
+        return HelloImGui::LoadUserPref(userPrefName);
+    }
+
+    std::string SettingsJournalLocation(const HelloImGui::RunnerParams& runnerParams)
+    {
+        std::string iniLocation = HelloImGui::IniSettingsLocation(runnerParams);
+        if (iniLocation.empty())
+            return "";
+        return std::filesystem::path(iniLocation).replace_extension(".settings_journal").string();
+    }
+
+    // Called by the runner (see runner.cpp)
+    void Priv_SetupSettingsJournal(HelloImGui::RunnerParams& runnerParams, const AddOnsParams& addOnsParams)
+    {
+        gSettingsJournal.reset();
+        gImGuiIniRestored = false;
+        if (!addOnsParams.withJournaledSettings)
+            return;
+        std::string location = SettingsJournalLocation(runnerParams);
+        if (location.empty())
+            return;
+        // The file will be read lazily, when the settings are first accessed
+        gSettingsJournal = std::make_unique<SettingsJournal>(location);
+
+        runnerParams.callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.PreNewFrame,
+            JournalImGuiIniIfNeeded);
+    }
+
+    // Called by the runner, after the add-ons which store their settings in the journal were destroyed
+    void Priv_TearDownSettingsJournal()
+    {
+        if (gSettingsJournal == nullptr)
+            return;
+        // After a normal exit, HelloImGui has saved the ImGui settings in the ini file
+        gSettingsJournal->Erase("imgui.ini");
+        gSettingsJournal.reset();
+    }
+} // namespace ImmApp
@@ -0,0 +1,92 @@
+#pragma once
+#include "hello_imgui/hello_imgui.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+
+namespace ImmApp
+{
+    // SettingsJournal: a persistent key/value store for settings, which is written incrementally.
+    // - Set() appends the changed key to the journal file (unchanged values are not written),
+    //   so that the settings survive a crash, and nothing remains to be written at exit.
+    // - The file is read lazily, on the first access.
+    // - When the journal grows much larger than the live settings, it is compacted on a background thread.
+    //   Compaction never delays the exit: it is cancelled if the journal is closed in the meantime.
+    // All the methods are thread-safe.
+    //
+    // Each record is flushed to the OS when written: the settings survive an app crash
+    // (but not necessarily a power loss). A record torn by a crash is ignored when loading.
+    class SettingsJournal
+    {
+    public:
+        explicit SettingsJournal(const std::string& filename);
+        ~SettingsJournal();
+        SettingsJournal(const SettingsJournal&) = delete;
+        SettingsJournal& operator=(const SettingsJournal&) = delete;
+
+        std::optional<std::string> Get(const std::string& key);
+        bool Has(const std::string& key);
+        void Set(const std::string& key, const std::string& value);
+        void Erase(const std::string& key);
+
+        // Rewrites the journal with only the live settings (synchronously)
+        void Compact();
+
+        const std::string& Filename() const { return mFilename; }
+
+    private:
+        void LoadIfNeeded();
+        void AppendRecord(char op, const std::string& key, const std::string& value);
+        void CompactIfNeeded();
+        bool WriteCompactedJournal(const std::map<std::string, std::string>& settings, const std::string& tmpFilename);
+        void FinishCompaction(const std::string& tmpFilename);
+        void JoinCompactionThread();
+
+        std::string mFilename;
+        std::recursive_mutex mMutex;
+        bool mIsLoaded = false;
+        std::map<std::string, std::string> mSettings;
+        size_t mLiveBytes = 0;
+        size_t mJournalBytes = 0;
+        FILE* mJournalFile = nullptr;
+
+        // Background compaction: the records appended while the snapshot is written are replayed afterward
+        std::thread mCompactionThread;
+        std::atomic<bool> mCancelCompaction { false };
+        bool mIsCompacting = false;
+        std::string mRecordsDuringCompaction;
+    };
+
+
+    // Journaled settings of the app: when AddOnsParams::withJournaledSettings is true, ImmApp opens a SettingsJournal
+    // next to the ini file (see SettingsJournalLocation), and stores in it:
+    // - the node editor settings (instead of rewriting the whole .node_editor.json file at each change):
+    //   one key per node, and one for the view state. An existing .node_editor.json file is imported once.
+    //   Note: the node editor still serializes all the nodes when it saves its settings (e.g. when destroyed);
+    //   they are only parsed if the view state changed.
+    // - the ImGui ini settings, whenever ImGui marks them as modified: if the app crashes, they are
+    //   restored at the next start (after a normal exit, HelloImGui saves them in the ini file as usual).
+    // - the user preferences saved with SaveUserPrefToJournal().
+    // Apps may store their own settings in it, via GetSettingsJournal().
+
+    // Returns the settings journal of the running app (nullptr if AddOnsParams::withJournaledSettings is false)
+    SettingsJournal* GetSettingsJournal();
+
+    // SettingsJournalLocation returns the path to the settings journal:
+    // path/to/your/app.ini => path/to/your/app.settings_journal
+    std::string SettingsJournalLocation(const HelloImGui::RunnerParams& runnerParams);
+
+    // SaveUserPrefToJournal / LoadUserPrefFromJournal: same as HelloImGui::SaveUserPref / LoadUserPref,
+    // but the preference is written to the settings journal as soon as it is saved (not only at exit).
+    // If the journal is disabled, they call HelloImGui::SaveUserPref / LoadUserPref.
+    // LoadUserPrefFromJournal falls back to the preferences saved by HelloImGui::SaveUserPref.
+    void SaveUserPrefToJournal(const std::string& userPrefName, const std::string& userPrefContent);
+    std::string LoadUserPrefFromJournal(const std::string& userPrefName);
+} // namespace ImmApp
@@ -174,7 +174,7 @@ namespace Snippets
                 ImGui::SetCursorPos({topRight.x - lineHeight * 1.5f, topRight.y});
                 if (ImGui::Button(ICON_FA_COPY))
                 {
-                    timeClickCopyButton[id] = ImmApp::ClockSeconds();
+                    timeClickCopyButton[id] = ImmApp::GetFrameClock().frameTime;
                     ImGui::SetClipboardText(snippetData.Code.c_str());
                     #ifdef __EMSCRIPTEN__
                     JsClipboard_SetClipboardText(snippetData.Code.c_str());
@@ -184,7 +184,7 @@ namespace Snippets
                 bool wasCopiedRecently = false;
                 if (fplus::map_contains(timeClickCopyButton, id))
                 {
-                    double now = ImmApp::ClockSeconds();
+                    double now = ImmApp::GetFrameClock().frameTime;
                     double deltaTime = now - timeClickCopyButton.at(id);
                     if (deltaTime < 0.7)
                         wasCopiedRecently = true;
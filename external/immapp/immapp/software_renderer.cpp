@@ -0,0 +1,399 @@
+#include "immapp/software_renderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        // Pixels are handled as ImU32 (R in the low byte, A in the high byte), i.e. RGBA bytes in memory
+        struct SoftwareTexture
+        {
+            const ImU32* pixels = nullptr;
+            int width = 0;
+            int height = 0;
+        };
+
+        std::mutex gTexturesMutex;
+        std::unordered_map<ImTextureID, SoftwareTexture> gTextures;
+
+        SoftwareImage gFinalSoftwareScreenshot;
+
+        const ImU32 kWhitePixel = IM_COL32_WHITE;
+
+
+        // x * y / 255, rounded
+        inline ImU32 MulDiv255(ImU32 x, ImU32 y)
+        {
+            ImU32 v = x * y + 128;
+            return (v + (v >> 8)) >> 8;
+        }
+
+        inline ImU32 Modulate(ImU32 a, ImU32 b)
+        {
+            ImU32 r = MulDiv255(a & 0xFF, b & 0xFF);
+            ImU32 g = MulDiv255((a >> 8) & 0xFF, (b >> 8) & 0xFF);
+            ImU32 bl = MulDiv255((a >> 16) & 0xFF, (b >> 16) & 0xFF);
+            ImU32 al = MulDiv255(a >> 24, b >> 24);
+            return r | (g << 8) | (bl << 16) | (al << 24);
+        }
+
+        // Same blending as the OpenGL backend:
+        //   rgb = src.rgb * src.a + dst.rgb * (1 - src.a)
+        //   a   = src.a           + dst.a   * (1 - src.a)
+        inline ImU32 BlendOver(ImU32 dst, ImU32 src)
+        {
+            ImU32 sa = src >> 24;
+            if (sa == 0)
+                return dst;
+            if (sa == 255)
+                return src;
+            ImU32 ia = 255 - sa;
+            ImU32 r = MulDiv255(src & 0xFF, sa) + MulDiv255(dst & 0xFF, ia);
+            ImU32 g = MulDiv255((src >> 8) & 0xFF, sa) + MulDiv255((dst >> 8) & 0xFF, ia);
+            ImU32 b = MulDiv255((src >> 16) & 0xFF, sa) + MulDiv255((dst >> 16) & 0xFF, ia);
+            ImU32 a = sa + MulDiv255(dst >> 24, ia);
+            return r | (g << 8) | (b << 16) | (a << 24);
+        }
+
+        // Blends a constant color over a span: this is the hot loop for rectangles and anti-aliasing fringes.
+        // It is branch-free, so that the compiler can vectorize it.
+        void BlendSpanConstant(ImU32* dst, int count, ImU32 src)
+        {
+            ImU32 sa = src >> 24;
+            if (sa == 0)
+                return;
+            if (sa == 255)
+            {
+                std::fill(dst, dst + count, src);
+                return;
+            }
+            ImU32 ia = 255 - sa;
+            ImU32 sr = MulDiv255(src & 0xFF, sa), sg = MulDiv255((src >> 8) & 0xFF, sa), sb = MulDiv255((src >> 16) & 0xFF, sa);
+            for (int i = 0; i < count; ++i)
+            {
+                ImU32 d = dst[i];
+                ImU32 r = sr + MulDiv255(d & 0xFF, ia);
+                ImU32 g = sg + MulDiv255((d >> 8) & 0xFF, ia);
+                ImU32 b = sb + MulDiv255((d >> 16) & 0xFF, ia);
+                ImU32 a = sa + MulDiv255(d >> 24, ia);
+                dst[i] = r | (g << 8) | (b << 16) | (a << 24);
+            }
+        }
+
+        inline ImU32 SampleNearest(const SoftwareTexture& texture, float u, float v)
+        {
+            int x = (int)(u * (float)texture.width);
+            int y = (int)(v * (float)texture.height);
+            x = std::clamp(x, 0, texture.width - 1);
+            y = std::clamp(y, 0, texture.height - 1);
+            return texture.pixels[(size_t)y * texture.width + x];
+        }
+
+        inline ImU32 PackColor(float r, float g, float b, float a)
+        {
+            auto toByte = [](float c) { return (ImU32)std::clamp((int)(c + 0.5f), 0, 255); };
+            return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (toByte(a) << 24);
+        }
+
+        struct PixelRect { int x0, y0, x1, y1; }; // x1 and y1 are exclusive
+
+        struct RenderContext
+        {
+            ImDrawData* drawData = nullptr;
+            ImVec2 scale;
+            ImU32* image = nullptr;
+            int width = 0;
+            int height = 0;
+            std::unordered_map<ImTextureID, SoftwareTexture> textures;
+            SoftwareTexture fontTexture;
+            ImTextureID fontTextureId = ImTextureID();
+        };
+
+        SoftwareTexture FindTexture(const RenderContext& ctx, ImTextureID textureId)
+        {
+            auto it = ctx.textures.find(textureId);
+            if (it != ctx.textures.end())
+                return it->second;
+            if (textureId == ctx.fontTextureId && ctx.fontTexture.pixels != nullptr)
+                return ctx.fontTexture;
+            return SoftwareTexture{ &kWhitePixel, 1, 1 };
+        }
+
+        // A value interpolated linearly over the triangle: value(x, y) = origin + dx * x + dy * y
+        struct Gradient
+        {
+            float origin, dx, dy;
+            float At(float x, float y) const { return origin + dx * x + dy * y; }
+        };
+
+        Gradient MakeGradient(const ImVec2 p[3], float area, float a0, float a1, float a2)
+        {
+            // From the barycentric coordinates of (x, y)
+            float dx = ((p[1].y - p[2].y) * a0 + (p[2].y - p[0].y) * a1 + (p[0].y - p[1].y) * a2) / area;
+            float dy = ((p[2].x - p[1].x) * a0 + (p[0].x - p[2].x) * a1 + (p[1].x - p[0].x) * a2) / area;
+            return Gradient{ a0 - dx * p[0].x - dy * p[0].y, dx, dy };
+        }
+
+        // Rasterizes a triangle inside clip (the clip rect intersected with the current band).
+        // Pixel centers are at +0.5, and a top-left fill rule is used, so that adjacent triangles
+        // never cover a pixel twice (which would be visible with alpha blending).
+        void RasterizeTriangle(const RenderContext& ctx, const ImDrawVert* v[3], const ImVec2 p[3],
+                               const SoftwareTexture& texture, const PixelRect& clip)
+        {
+            float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+            if (std::fabs(area) < 1e-6f)
+                return;
+
+            // Order the vertices, so that area > 0 (ImGui emits both windings)
+            int i0 = 0, i1 = 1, i2 = 2;
+            if (area < 0.f)
+            {
+                std::swap(i1, i2);
+                area = -area;
+            }
+            const ImVec2 q[3] = { p[i0], p[i1], p[i2] };
+            const ImDrawVert* w[3] = { v[i0], v[i1], v[i2] };
+
+            int y0 = std::max(clip.y0, (int)std::floor(std::min({ q[0].y, q[1].y, q[2].y })));
+            int y1 = std::min(clip.y1, (int)std::ceil(std::max({ q[0].y, q[1].y, q[2].y })));
+            if (y0 >= y1)
+                return;
+
+            // Edge functions: e(x, y) = a * x + b * y + c >= 0 inside the triangle, for each edge (q[k] -> q[k+1]).
+            // A pixel on an edge belongs to the triangle if a > 0, or (a == 0 and b > 0):
+            // the shared edge of two adjacent triangles has opposite coefficients, so that only one owns it.
+            struct Edge { float a, b, c; bool inclusive; };
+            Edge edges[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                const ImVec2& pa = q[k];
+                const ImVec2& pb = q[(k + 1) % 3];
+                Edge& e = edges[k];
+                e.a = -(pb.y - pa.y);
+                e.b = pb.x - pa.x;
+                e.c = -(e.a * pa.x + e.b * pa.y);
+                e.inclusive = (e.a > 0.f) || (e.a == 0.f && e.b > 0.f);
+            }
+
+            ImU32 col0 = w[0]->col;
+            bool sameColor = (col0 == w[1]->col) && (col0 == w[2]->col);
+            bool sameUv = (w[0]->uv.x == w[1]->uv.x && w[0]->uv.x == w[2]->uv.x
+                           && w[0]->uv.y == w[1]->uv.y && w[0]->uv.y == w[2]->uv.y);
+
+            ImU32 constantColor = 0;
+            Gradient gu{}, gv{}, gr{}, gg{}, gb{}, ga{};
+            ImU32 constantTexel = 0;
+            if (sameUv)
+                constantTexel = SampleNearest(texture, w[0]->uv.x, w[0]->uv.y);
+            if (sameColor && sameUv)
+                constantColor = Modulate(constantTexel, col0);
+            if (!sameUv)
+            {
+                gu = MakeGradient(q, area, w[0]->uv.x, w[1]->uv.x, w[2]->uv.x);
+                gv = MakeGradient(q, area, w[0]->uv.y, w[1]->uv.y, w[2]->uv.y);
+            }
+            if (!sameColor)
+            {
+                auto channel = [](ImU32 c, int shift) { return (float)((c >> shift) & 0xFF); };
+                gr = MakeGradient(q, area, channel(w[0]->col, 0), channel(w[1]->col, 0), channel(w[2]->col, 0));
+                gg = MakeGradient(q, area, channel(w[0]->col, 8), channel(w[1]->col, 8), channel(w[2]->col, 8));
+                gb = MakeGradient(q, area, channel(w[0]->col, 16), channel(w[1]->col, 16), channel(w[2]->col, 16));
+                ga = MakeGradient(q, area, channel(w[0]->col, 24), channel(w[1]->col, 24), channel(w[2]->col, 24));
+            }
+
+            for (int y = y0; y < y1; ++y)
+            {
+                float cy = (float)y + 0.5f;
+
+                // The span [xMin, xMax) of pixel centers inside the triangle, computed from the edges
+                float xMin = -1e30f, xMax = 1e30f;
+                bool empty = false;
+                for (const Edge& e : edges)
+                {
+                    float rowValue = e.b * cy + e.c; // e(x) = a * x + rowValue
+                    if (e.a > 0.f)
+                        xMin = std::max(xMin, -rowValue / e.a);      // e(x) >= 0  <=>  x >= -rowValue / a
+                    else if (e.a < 0.f)
+                        xMax = std::min(xMax, -rowValue / e.a);      // e(x) >  0  <=>  x <  -rowValue / a
+                    else if (rowValue < 0.f || (rowValue == 0.f && !e.inclusive))
+                        empty = true;
+                }
+                if (empty)
+                    continue;
+                // Pixel x is covered when xMin <= x + 0.5 < xMax
+                int x0 = std::max(clip.x0, (int)std::ceil(std::max(xMin, -1e9f) - 0.5f));
+                int x1 = std::min(clip.x1, (int)std::ceil(std::min(xMax, 1e9f) - 0.5f));
+                if (x0 >= x1)
+                    continue;
+
+                ImU32* row = ctx.image + (size_t)y * ctx.width;
+                if (sameColor && sameUv)
+                {
+                    BlendSpanConstant(row + x0, x1 - x0, constantColor);
+                    continue;
+                }
+
+                for (int x = x0; x < x1; ++x)
+                {
+                    float cx = (float)x + 0.5f;
+                    ImU32 texel = sameUv ? constantTexel : SampleNearest(texture, gu.At(cx, cy), gv.At(cx, cy));
+                    ImU32 color = sameColor ? col0 : PackColor(gr.At(cx, cy), gg.At(cx, cy), gb.At(cx, cy), ga.At(cx, cy));
+                    row[x] = BlendOver(row[x], Modulate(texel, color));
+                }
+            }
+        }
+
+        // Renders all the draw commands which intersect the rows [bandY0, bandY1)
+        void RenderBand(const RenderContext& ctx, int bandY0, int bandY1)
+        {
+            ImDrawData* drawData = ctx.drawData;
+            ImVec2 displayPos = drawData->DisplayPos;
+            for (int n = 0; n < drawData->CmdListsCount; ++n)
+            {
+                const ImDrawList* drawList = drawData->CmdLists[n];
+                const ImDrawVert* vtxBuffer = drawList->VtxBuffer.Data;
+                const ImDrawIdx* idxBuffer = drawList->IdxBuffer.Data;
+                for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+                {
+                    if (cmd.UserCallback != nullptr)
+                        continue; // Callbacks (including ImDrawCallback_ResetRenderState) target a GPU backend
+
+                    PixelRect clip;
+                    clip.x0 = std::max(0, (int)std::floor((cmd.ClipRect.x - displayPos.x) * ctx.scale.x));
+                    clip.y0 = std::max(bandY0, (int)std::floor((cmd.ClipRect.y - displayPos.y) * ctx.scale.y));
+                    clip.x1 = std::min(ctx.width, (int)std::ceil((cmd.ClipRect.z - displayPos.x) * ctx.scale.x));
+                    clip.y1 = std::min(bandY1, (int)std::ceil((cmd.ClipRect.w - displayPos.y) * ctx.scale.y));
+                    if (clip.x0 >= clip.x1 || clip.y0 >= clip.y1)
+                        continue;
+
+                    SoftwareTexture texture = FindTexture(ctx, cmd.GetTexID());
+                    const ImDrawIdx* indices = idxBuffer + cmd.IdxOffset;
+                    const ImDrawVert* vertices = vtxBuffer + cmd.VtxOffset;
+                    for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3)
+                    {
+                        const ImDrawVert* v[3] = { &vertices[indices[i]], &vertices[indices[i + 1]], &vertices[indices[i + 2]] };
+                        ImVec2 p[3];
+                        for (int k = 0; k < 3; ++k)
+                            p[k] = ImVec2((v[k]->pos.x - displayPos.x) * ctx.scale.x, (v[k]->pos.y - displayPos.y) * ctx.scale.y);
+
+                        // Most triangles do not intersect this band
+                        float minY = std::min({ p[0].y, p[1].y, p[2].y });
+                        float maxY = std::max({ p[0].y, p[1].y, p[2].y });
+                        if (maxY <= (float)clip.y0 || minY >= (float)clip.y1)
+                            continue;
+
+                        RasterizeTriangle(ctx, v, p, texture, clip);
+                    }
+                }
+            }
+        }
+    } // anonymous namespace
+
+
+    void SoftwareRenderDrawData(ImDrawData* drawData, SoftwareImage* outImage, const SoftwareRendererParams& params)
+    {
+        IM_ASSERT(outImage != nullptr);
+        if (drawData == nullptr)
+        {
+            *outImage = SoftwareImage();
+            return;
+        }
+
+        RenderContext ctx;
+        ctx.drawData = drawData;
+        ctx.scale = drawData->FramebufferScale;
+        ctx.width = (int)(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+        ctx.height = (int)(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+        ctx.width = std::max(ctx.width, 0);
+        ctx.height = std::max(ctx.height, 0);
+
+        outImage->width = ctx.width;
+        outImage->height = ctx.height;
+        outImage->pixels.resize((size_t)ctx.width * ctx.height * 4);
+        ctx.image = reinterpret_cast<ImU32*>(outImage->pixels.data());
+
+        ImVec4 clear = params.clearColor;
+        ImU32 clearColor = PackColor(clear.x * 255.f, clear.y * 255.f, clear.z * 255.f, clear.w * 255.f);
+        std::fill(ctx.image, ctx.image + (size_t)ctx.width * ctx.height, clearColor);
+        if (ctx.width == 0 || ctx.height == 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(gTexturesMutex);
+            ctx.textures = gTextures;
+        }
+        if (ImGui::GetCurrentContext() != nullptr)
+        {
+            ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+            unsigned char* fontPixels = nullptr;
+            int fontWidth = 0, fontHeight = 0;
+            fonts->GetTexDataAsRGBA32(&fontPixels, &fontWidth, &fontHeight);
+            if (fontPixels != nullptr)
+            {
+                ctx.fontTexture = SoftwareTexture{ reinterpret_cast<const ImU32*>(fontPixels), fontWidth, fontHeight };
+                ctx.fontTextureId = fonts->TexID;
+            }
+        }
+
+        // The bands are distributed dynamically between the threads (their cost depends on the UI contents)
+        int bandHeight = std::max(params.bandHeight, 1);
+        int nbBands = (ctx.height + bandHeight - 1) / bandHeight;
+        int nbThreads = params.nbThreads > 0 ? params.nbThreads : (int)std::thread::hardware_concurrency();
+        nbThreads = std::clamp(nbThreads, 1, nbBands);
+
+        std::atomic<int> nextBand{0};
+        auto worker = [&]()
+        {
+            for (int band = nextBand++; band < nbBands; band = nextBand++)
+            {
+                int bandY0 = band * bandHeight;
+                RenderBand(ctx, bandY0, std::min(bandY0 + bandHeight, ctx.height));
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int i = 1; i < nbThreads; ++i)
+            threads.emplace_back(worker);
+        worker();
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    void SoftwareRendererRegisterTexture(ImTextureID textureId, const uint8_t* rgbaPixels, int width, int height)
+    {
+        IM_ASSERT(rgbaPixels != nullptr && width > 0 && height > 0);
+        std::lock_guard<std::mutex> lock(gTexturesMutex);
+        gTextures[textureId] = SoftwareTexture{ reinterpret_cast<const ImU32*>(rgbaPixels), width, height };
+    }
+
+    void SoftwareRendererUnregisterTexture(ImTextureID textureId)
+    {
+        std::lock_guard<std::mutex> lock(gTexturesMutex);
+        gTextures.erase(textureId);
+    }
+
+    const SoftwareImage& FinalAppWindowSoftwareScreenshot()
+    {
+        return gFinalSoftwareScreenshot;
+    }
+
+    // Called by the runner (see runner.cpp) before exiting, when the renderer backend is Null
+    void Priv_CaptureFinalSoftwareScreenshot(const ImVec4& clearColor)
+    {
+        SoftwareRendererParams params;
+        params.clearColor = clearColor;
+        SoftwareRenderDrawData(ImGui::GetDrawData(), &gFinalSoftwareScreenshot, params);
+    }
+
+    void Priv_ResetFinalSoftwareScreenshot()
+    {
+        gFinalSoftwareScreenshot = SoftwareImage();
+    }
+} // namespace ImmApp
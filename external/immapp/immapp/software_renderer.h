@@ -0,0 +1,49 @@
+#pragma once
+#include "imgui.h"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace ImmApp
+{
+    // Software renderer: rasterizes ImDrawData on the CPU into an RGBA image.
+    // Useful to produce screenshots (golden images, notebook thumbnails) on machines without a GPU,
+    // e.g. when running with HelloImGui::RendererBackendType::Null.
+    //
+    // Supports textured triangles (nearest sampling), per-vertex colors, clip rects and alpha blending
+    // (same blending as the OpenGL backend). Draw callbacks are ignored.
+    // The image is split into bands of rows, which are rasterized in parallel.
+
+    // An RGBA image, 4 bytes per pixel, rows are contiguous
+    struct SoftwareImage
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    struct SoftwareRendererParams
+    {
+        // Number of threads (0: use all the hardware threads)
+        int nbThreads = 0;
+        // Height of the bands of rows processed by each task
+        int bandHeight = 32;
+        // The image is cleared with this color before rendering
+        ImVec4 clearColor = ImVec4(0.f, 0.f, 0.f, 1.f);
+    };
+
+    // Renders drawData into outImage (of size DisplaySize * FramebufferScale).
+    // The font atlas texture is read from ImGui::GetIO().Fonts; other textures must be registered
+    // with SoftwareRendererRegisterTexture (unknown textures are drawn as white).
+    void SoftwareRenderDrawData(ImDrawData* drawData, SoftwareImage* outImage,
+                                const SoftwareRendererParams& params = SoftwareRendererParams());
+
+    // Registers an RGBA texture (the pixels are not copied: they must stay valid until unregistered)
+    void SoftwareRendererRegisterTexture(ImTextureID textureId, const uint8_t* rgbaPixels, int width, int height);
+    void SoftwareRendererUnregisterTexture(ImTextureID textureId);
+
+    // When the renderer backend is Null, ImmApp renders the last frame with the software renderer
+    // before exiting. Returns this image (empty if the app did not use the Null renderer).
+    const SoftwareImage& FinalAppWindowSoftwareScreenshot();
+} // namespace ImmApp
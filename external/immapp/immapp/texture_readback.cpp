@@ -0,0 +1,311 @@
+#include "immapp/texture_readback.h"
+#include "immapp/runner.h"
+#include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/internal/functional_utils.h"
+#ifdef HELLOIMGUI_HAS_OPENGL
+#include "hello_imgui/hello_imgui_include_opengl.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+
+namespace ImmApp
+{
+#ifdef HELLOIMGUI_HAS_OPENGL
+    namespace
+    {
+        // Restores the bindings modified by a readback (it may run inside the ImGui renderer, see the screenshots)
+        struct ReadbackStateBackup
+        {
+            GLint pixelPackBuffer = 0, readFramebuffer = 0, packAlignment = 0;
+            ReadbackStateBackup()
+            {
+                glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &pixelPackBuffer);
+                glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+                glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+            }
+            ~ReadbackStateBackup()
+            {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, (GLuint)pixelPackBuffer);
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)readFramebuffer);
+                glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+            }
+        };
+
+        void CopyRows(const uint8_t* src, ReadbackImage* image, bool flipRows)
+        {
+            size_t rowSize = (size_t)image->width * 4;
+            image->pixels.resize(rowSize * (size_t)image->height);
+            if (!flipRows)
+            {
+                memcpy(image->pixels.data(), src, image->pixels.size());
+                return;
+            }
+            for (int row = 0; row < image->height; ++row)
+                memcpy(image->pixels.data() + (size_t)(image->height - 1 - row) * rowSize, src + (size_t)row * rowSize, rowSize);
+        }
+    } // anonymous namespace
+#endif
+
+
+    AsyncReadback::AsyncReadback(int nbBuffers)
+        : mSlots((size_t)std::max(nbBuffers, 1))
+    {
+    }
+
+    AsyncReadback::~AsyncReadback()
+    {
+        Release();
+    }
+
+    void AsyncReadback::Release()
+    {
+#ifdef HELLOIMGUI_HAS_OPENGL
+        for (Slot& slot : mSlots)
+        {
+            if (slot.fence != nullptr)
+                glDeleteSync((GLsync)slot.fence);
+            if (slot.pixelBuffer != 0)
+                glDeleteBuffers(1, &slot.pixelBuffer);
+            slot = Slot();
+        }
+        if (mReadFramebuffer != 0)
+            glDeleteFramebuffers(1, &mReadFramebuffer);
+        mReadFramebuffer = 0;
+#endif
+        mPendingOrder.clear();
+    }
+
+    int AsyncReadback::NbPendingRequests() const
+    {
+        return (int)mPendingOrder.size();
+    }
+
+    AsyncReadback::Slot* AsyncReadback::AcquireSlot(int x, int y, int width, int height)
+    {
+        if (width <= 0 || height <= 0)
+            return nullptr;
+        for (size_t i = 0; i < mSlots.size(); ++i)
+        {
+            Slot& slot = mSlots[i];
+            if (slot.isPending)
+                continue;
+            slot.isPending = true;
+            slot.image.x = x;
+            slot.image.y = y;
+            slot.image.width = width;
+            slot.image.height = height;
+            slot.image.requestFrame = ImGui::GetFrameCount();
+            mPendingOrder.push_back((int)i);
+            return &slot;
+        }
+        return nullptr;
+    }
+
+    // Reads the region of slot->image from the framebuffer bound for reading (at glX, glY in OpenGL coordinates)
+    void AsyncReadback::ReadPixelsIntoSlot(Slot* slot, int glX, int glY)
+    {
+#ifdef HELLOIMGUI_HAS_OPENGL
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+#ifdef __EMSCRIPTEN__
+        // WebGL2 cannot map buffers: read synchronously (Poll() will receive the pixels)
+        std::vector<uint8_t> pixels((size_t)slot->image.width * (size_t)slot->image.height * 4);
+        glReadPixels(glX, glY, slot->image.width, slot->image.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        CopyRows(pixels.data(), &slot->image, slot->flipRows);
+#else
+        size_t size = (size_t)slot->image.width * (size_t)slot->image.height * 4;
+        if (slot->pixelBuffer == 0)
+            glGenBuffers(1, &slot->pixelBuffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pixelBuffer);
+        if (slot->capacity < size)
+        {
+            glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)size, nullptr, GL_STREAM_READ);
+            slot->capacity = size;
+        }
+        // With a pixel pack buffer bound, glReadPixels only queues the copy
+        glReadPixels(glX, glY, slot->image.width, slot->image.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        slot->fence = (void*)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+#else
+        IM_UNUSED(slot); IM_UNUSED(glX); IM_UNUSED(glY);
+#endif
+    }
+
+    bool AsyncReadback::RequestTextureRegion(ImTextureID texture, int x, int y, int width, int height)
+    {
+#ifdef HELLOIMGUI_HAS_OPENGL
+        Slot* slot = AcquireSlot(x, y, width, height);
+        if (slot == nullptr)
+            return false;
+        // The rows of a texture are in the order in which they were uploaded (top row first for images)
+        slot->flipRows = false;
+
+        ReadbackStateBackup stateBackup;
+        if (mReadFramebuffer == 0)
+            glGenFramebuffers(1, &mReadFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, mReadFramebuffer);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, (GLuint)(intptr_t)texture, 0);
+        if (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            // Not a color renderable texture
+            mPendingOrder.pop_back();
+            slot->isPending = false;
+            return false;
+        }
+        ReadPixelsIntoSlot(slot, x, y);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+        return true;
+#else
+        IM_UNUSED(texture); IM_UNUSED(x); IM_UNUSED(y); IM_UNUSED(width); IM_UNUSED(height);
+        return false;
+#endif
+    }
+
+    bool AsyncReadback::RequestFramebufferRegion(int x, int y, int width, int height, int framebufferHeight)
+    {
+#ifdef HELLOIMGUI_HAS_OPENGL
+        Slot* slot = AcquireSlot(x, y, width, height);
+        if (slot == nullptr)
+            return false;
+        // The rows of a framebuffer are bottom up
+        slot->flipRows = true;
+        ReadbackStateBackup stateBackup;
+        ReadPixelsIntoSlot(slot, x, framebufferHeight - y - height);
+        return true;
+#else
+        IM_UNUSED(x); IM_UNUSED(y); IM_UNUSED(width); IM_UNUSED(height); IM_UNUSED(framebufferHeight);
+        return false;
+#endif
+    }
+
+    bool AsyncReadback::Poll()
+    {
+        bool updated = false;
+#ifdef HELLOIMGUI_HAS_OPENGL
+        // The requests are received in order: a request is not finished before the previous ones
+        while (!mPendingOrder.empty())
+        {
+            Slot& slot = mSlots[(size_t)mPendingOrder.front()];
+            if (slot.fence != nullptr)
+            {
+                GLenum status = glClientWaitSync((GLsync)slot.fence, 0, 0);
+                if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                    break;
+                glDeleteSync((GLsync)slot.fence);
+                slot.fence = nullptr;
+
+                GLint previousPixelPackBuffer = 0;
+                glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previousPixelPackBuffer);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+                size_t size = (size_t)slot.image.width * (size_t)slot.image.height * 4;
+                const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+                if (mapped != nullptr)
+                {
+                    CopyRows(static_cast<const uint8_t*>(mapped), &slot.image, slot.flipRows);
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, (GLuint)previousPixelPackBuffer);
+                if (mapped == nullptr)
+                    slot.image.pixels.clear();
+            }
+            slot.isPending = false;
+            mPendingOrder.erase(mPendingOrder.begin());
+            if (slot.image.pixels.empty())
+                continue;
+            std::swap(mLatestImage, slot.image);
+            updated = true;
+        }
+#endif
+        return updated;
+    }
+
+
+    // Asynchronous screenshots of the app window
+    // ------------------------------------------
+    namespace
+    {
+        std::atomic<bool> gScreenshotRequested { false };
+        std::unique_ptr<AsyncReadback> gScreenshotReadback;
+        ReadbackImage gReceivedScreenshot;
+        bool gHasReceivedScreenshot = false;
+
+#ifdef HELLOIMGUI_HAS_OPENGL
+        // Runs inside the renderer, after the main viewport was drawn (see QueueScreenshotIfRequested)
+        void ScreenshotDrawCallback(const ImDrawList*, const ImDrawCmd*)
+        {
+            ImDrawData* drawData = ImGui::GetMainViewport()->DrawData;
+            if (drawData == nullptr || gScreenshotReadback == nullptr)
+                return;
+            int width = (int)(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+            int height = (int)(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+            if (!gScreenshotReadback->RequestFramebufferRegion(0, 0, width, height, height))
+                gScreenshotRequested = true; // All the buffers are in flight: retry at the next frame
+        }
+
+        // The foreground draw list is rendered last: a callback at its end sees the whole frame
+        void QueueScreenshotIfRequested()
+        {
+            if (!gScreenshotRequested.exchange(false))
+                return;
+            if (gScreenshotReadback == nullptr)
+                gScreenshotReadback = std::make_unique<AsyncReadback>(2);
+            ImGui::GetForegroundDrawList(ImGui::GetMainViewport())->AddCallback(ScreenshotDrawCallback, nullptr);
+        }
+
+        void ReceiveScreenshots()
+        {
+            if (gScreenshotReadback != nullptr && gScreenshotReadback->Poll())
+            {
+                gReceivedScreenshot = gScreenshotReadback->LatestImage();
+                gHasReceivedScreenshot = true;
+            }
+        }
+
+        void ReleaseScreenshotReadback()
+        {
+            gScreenshotReadback.reset();
+        }
+#endif
+    } // anonymous namespace
+
+    void RequestAppWindowScreenshot()
+    {
+        gScreenshotRequested = true;
+    }
+
+    bool PollAppWindowScreenshot(ReadbackImage* outScreenshot)
+    {
+        if (!gHasReceivedScreenshot)
+            return false;
+        *outScreenshot = std::move(gReceivedScreenshot);
+        gReceivedScreenshot = ReadbackImage();
+        gHasReceivedScreenshot = false;
+        return true;
+    }
+
+    // Called by the runner (see runner.cpp)
+    void Priv_SetupTextureReadback(HelloImGui::RunnerParams& runnerParams)
+    {
+        gScreenshotRequested = false;
+        gHasReceivedScreenshot = false;
+#ifdef HELLOIMGUI_HAS_OPENGL
+        if (runnerParams.rendererBackendType != HelloImGui::RendererBackendType::OpenGL3)
+            return;
+        runnerParams.callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.PreNewFrame,
+            ReceiveScreenshots);
+        runnerParams.callbacks.BeforeImGuiRender = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.BeforeImGuiRender,
+            QueueScreenshotIfRequested);
+        // The OpenGL objects must be deleted while the context exists
+        runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
+            ReleaseScreenshotReadback,
+            runnerParams.callbacks.BeforeExit);
+#else
+        IM_UNUSED(runnerParams);
+#endif
+    }
+} // namespace ImmApp
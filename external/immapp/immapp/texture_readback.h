@@ -0,0 +1,92 @@
+#pragma once
+#include "imgui.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace ImmApp
+{
+    // Asynchronous readback of textures and of the app window (OpenGL renderer only).
+    //
+    // Reading pixels into CPU memory (glReadPixels, glGetTexImage) stalls until the GPU has finished all
+    // the pending rendering. Here, the pixels are copied into a pixel buffer object, guarded by a fence:
+    // the requests return immediately, and the pixels are received one or two frames later, once the GPU
+    // has finished the copy (see Poll()).
+    // Read only the region you need (e.g. the visible, zoomed part of a texture in an inspector):
+    // the cost is proportional to the region size.
+    //
+    // All the methods must be called from the main thread (with the OpenGL context current).
+    // Under emscripten (WebGL2 cannot map buffers), the readback is synchronous.
+
+    // An RGBA image read from the GPU, 4 bytes per pixel, rows are contiguous, top row first
+    struct ReadbackImage
+    {
+        // Region which was read (in pixels, y downward)
+        int x = 0, y = 0;
+        int width = 0, height = 0;
+        std::vector<uint8_t> pixels;
+        // ImGui::GetFrameCount() when the readback was requested
+        int requestFrame = -1;
+    };
+
+    class AsyncReadback
+    {
+    public:
+        // nbBuffers: maximum number of requests in flight
+        explicit AsyncReadback(int nbBuffers = 3);
+        ~AsyncReadback();
+        AsyncReadback(const AsyncReadback&) = delete;
+        AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+        // Queues a copy of a region of an RGBA texture.
+        // Returns false if all the buffers are in flight (call Poll() at each frame to receive them)
+        bool RequestTextureRegion(ImTextureID texture, int x, int y, int width, int height);
+        // Queues a copy of a region of the framebuffer which is currently bound for reading
+        // (y downward: framebufferHeight is used to flip the region and the rows)
+        bool RequestFramebufferRegion(int x, int y, int width, int height, int framebufferHeight);
+
+        // Receives the requests which the GPU has finished, without waiting.
+        // Returns true if LatestImage() was updated
+        bool Poll();
+        const ReadbackImage& LatestImage() const { return mLatestImage; }
+        int NbPendingRequests() const;
+
+        // Deletes the OpenGL objects (called by the destructor: call it earlier if the OpenGL context
+        // is destroyed before this object)
+        void Release();
+
+    private:
+        struct Slot
+        {
+            unsigned int pixelBuffer = 0;
+            size_t capacity = 0;
+            void* fence = nullptr;  // GLsync
+            bool isPending = false;
+            bool flipRows = false;
+            ReadbackImage image;    // region and requestFrame (the pixels are received by Poll)
+        };
+        Slot* AcquireSlot(int x, int y, int width, int height);
+        void ReadPixelsIntoSlot(Slot* slot, int glX, int glY);
+
+        std::vector<Slot> mSlots;
+        // Slots indices, in the order of the requests
+        std::vector<int> mPendingOrder;
+        unsigned int mReadFramebuffer = 0;
+        ReadbackImage mLatestImage;
+    };
+
+
+    // Asynchronous screenshots of the app window (OpenGL renderer only).
+    // The screenshot is read back at the end of the rendering of the next frame (without stalling the GPU),
+    // and is available one or two frames later.
+    //     ImmApp::RequestAppWindowScreenshot();
+    //     ... then, at each frame:
+    //     ImmApp::ReadbackImage screenshot;
+    //     if (ImmApp::PollAppWindowScreenshot(&screenshot))
+    //         SaveImage(screenshot);
+    void RequestAppWindowScreenshot();
+    // Returns true (and fills outScreenshot) once a requested screenshot was received
+    bool PollAppWindowScreenshot(ReadbackImage* outScreenshot);
+} // namespace ImmApp
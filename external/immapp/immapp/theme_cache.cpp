@@ -0,0 +1,82 @@
+#include "immapp/theme_cache.h"
+
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        struct CachedStyle
+        {
+            ImGuiTheme::ImGuiTweakedTheme tweakedTheme;
+            ImGuiStyle style;
+        };
+
+        // The cache is cleared when it reaches this size (e.g. when tweaks are animated)
+        const size_t kMaxCachedStyles = 256;
+        std::unordered_multimap<ImU64, std::unique_ptr<CachedStyle>> gCachedStyles;
+
+        // Styles which were replaced by PushCachedTweakedTheme
+        std::vector<ImGuiStyle> gPushedStyles;
+
+        ImU64 HashTweakedTheme(const ImGuiTheme::ImGuiTweakedTheme& tweakedTheme)
+        {
+            ImU64 h = 0xcbf29ce484222325ULL ^ (ImU64)tweakedTheme.Theme;
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&tweakedTheme.Tweaks);
+            for (size_t i = 0; i < sizeof(ImGuiTheme::ImGuiThemeTweaks); ++i)
+                h = (h ^ bytes[i]) * 0x100000001b3ULL;
+            return h;
+        }
+
+        bool IsSameTweakedTheme(const ImGuiTheme::ImGuiTweakedTheme& a, const ImGuiTheme::ImGuiTweakedTheme& b)
+        {
+            // ImGuiThemeTweaks only contains floats
+            return a.Theme == b.Theme && memcmp(&a.Tweaks, &b.Tweaks, sizeof(ImGuiTheme::ImGuiThemeTweaks)) == 0;
+        }
+    } // anonymous namespace
+
+
+    const ImGuiStyle& CachedTweakedThemeStyle(const ImGuiTheme::ImGuiTweakedTheme& tweakedTheme)
+    {
+        ImU64 hash = HashTweakedTheme(tweakedTheme);
+        auto range = gCachedStyles.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+            if (IsSameTweakedTheme(it->second->tweakedTheme, tweakedTheme))
+                return it->second->style;
+
+        if (gCachedStyles.size() >= kMaxCachedStyles)
+            gCachedStyles.clear();
+        auto cachedStyle = std::make_unique<CachedStyle>();
+        cachedStyle->tweakedTheme = tweakedTheme;
+        cachedStyle->style = ImGuiTheme::TweakedThemeThemeToStyle(tweakedTheme);
+        const ImGuiStyle& style = cachedStyle->style;
+        gCachedStyles.emplace(hash, std::move(cachedStyle));
+        return style;
+    }
+
+    void PushCachedTweakedTheme(const ImGuiTheme::ImGuiTweakedTheme& tweakedTheme)
+    {
+        const ImGuiStyle& newStyle = CachedTweakedThemeStyle(tweakedTheme);
+        ImGuiStyle& style = ImGui::GetStyle();
+        gPushedStyles.push_back(style);
+        style = newStyle;
+    }
+
+    void PopCachedTweakedTheme()
+    {
+        IM_ASSERT(!gPushedStyles.empty() && "PopCachedTweakedTheme: too many calls");
+        if (gPushedStyles.empty())
+            return;
+        ImGui::GetStyle() = gPushedStyles.back();
+        gPushedStyles.pop_back();
+    }
+
+    void ClearThemeCache()
+    {
+        gCachedStyles.clear();
+    }
+} // namespace ImmApp
@@ -0,0 +1,24 @@
+#pragma once
+#include "hello_imgui/hello_imgui.h"
+
+
+namespace ImmApp
+{
+    // Theme cache: ImGuiTheme::PushTweakedTheme() computes a full ImGuiStyle from the theme and its tweaks
+    // (with HSV conversions of all the colors) at each call. When themes are pushed for sub-panels at every frame,
+    // use PushCachedTweakedTheme() / PopCachedTweakedTheme() instead: the style of a (theme, tweaks) pair
+    // is computed once, and pushing or popping it only copies a style.
+    //
+    // Call ClearThemeCache() if ImGuiTheme::TweakedThemeThemeToStyle() would give different results
+    // (e.g. after a DPI change). The cache is cleared when the app exits.
+
+    // Returns the style of a tweaked theme, computed on the first call for this theme and these tweaks.
+    // The reference is valid until the next call.
+    const ImGuiStyle& CachedTweakedThemeStyle(const ImGuiTheme::ImGuiTweakedTheme& tweakedTheme);
+
+    // Same as ImGuiTheme::PushTweakedTheme() / PopTweakedTheme(), with cached styles
+    void PushCachedTweakedTheme(const ImGuiTheme::ImGuiTweakedTheme& tweakedTheme);
+    void PopCachedTweakedTheme();
+
+    void ClearThemeCache();
+} // namespace ImmApp
@@ -40,6 +40,8 @@ def main():
         )
 
     options.fn_return_force_policy_reference_for_pointers__regex = "CreateNvgContext_HelloImGui"
+    # NvgFramebuffer: changing these requires reallocating the texture (use SetPixelRatio)
+    options.member_readonly_by_name__regex = r"^PixelRatio$|^Supersampling$"
 
     options.srcmlcpp_options.ignored_warning_parts.append("C style function pointers are poorly supported")
 
@@ -7,6 +7,7 @@
 #include <nanobind/stl/tuple.h>
 #include <nanobind/stl/vector.h>
 #include <nanobind/stl/function.h>
+#include <nanobind/stl/shared_ptr.h>
 #include <nanobind/ndarray.h>
 
 #include "nanovg.h"
@@ -836,19 +837,35 @@ void py_init_module_nanovg(nb::module_& m)
 
         auto pyNsNvgImgui_ClassNvgFramebuffer =
             nb::class_<NvgImgui::NvgFramebuffer>
-                (pyNsNvgImgui, "NvgFramebuffer", " NvgFramebuffer: a framebuffer that can be used by NanoVG + ImGui\n Internally stored inside the renderer backend (e.g. OpenGL)\n Note: this class can be instantiated only after a valid renderer backend (OpenGL) has been created")
+                (pyNsNvgImgui, "NvgFramebuffer", " NvgFramebuffer: a framebuffer that can be used by NanoVG + ImGui\n Internally stored inside the renderer backend (e.g. OpenGL)\n Note: this class can be instantiated only after a valid renderer backend (OpenGL) has been created\n\n Width and Height are expressed in drawing units: this is the size that NanoVG drawing functions see.\n The texture is allocated at Width * PixelRatio x Height * PixelRatio pixels, where PixelRatio defaults\n to ImGui::GetIO().DisplayFramebufferScale (so that the drawing is crisp on HiDPI screens).\n If Supersampling > 1, the drawing is rendered at Supersampling times this resolution, and then resolved\n (i.e. downscaled) into the texture.")
             .def_rw("vg", &NvgImgui::NvgFramebuffer::vg, "")
             .def_rw("width", &NvgImgui::NvgFramebuffer::Width, "")
             .def_rw("height", &NvgImgui::NvgFramebuffer::Height, "")
             .def_rw("nvg_image_flags", &NvgImgui::NvgFramebuffer::NvgImageFlags, "")
             .def_rw("texture_id", &NvgImgui::NvgFramebuffer::TextureId, "")
-            .def(nb::init<NVGcontext *, int, int, int>(),
-                nb::arg("vg"), nb::arg("width"), nb::arg("height"), nb::arg("nvg_image_flags"),
-                "See NVGimageFlags")
+            .def_ro("pixel_ratio", &NvgImgui::NvgFramebuffer::PixelRatio, "Ratio between texture pixels and drawing units (read-only: use SetPixelRatio or UpdateResolutionTier)")
+            .def_ro("supersampling", &NvgImgui::NvgFramebuffer::Supersampling, "Supersampling factor (1 = no supersampling, 2 = render at 2x2 resolution then resolve, etc.)\n (read-only: use SetPixelRatio)")
+            .def_rw("min_pixel_ratio", &NvgImgui::NvgFramebuffer::MinPixelRatio, "Bounds for the pixel ratio selected by UpdateResolutionTier")
+            .def_rw("max_pixel_ratio", &NvgImgui::NvgFramebuffer::MaxPixelRatio, "")
+            .def(nb::init<NVGcontext *, int, int, int, float, int>(),
+                nb::arg("vg"), nb::arg("width"), nb::arg("height"), nb::arg("nvg_image_flags"), nb::arg("pixel_ratio") = -1.f, nb::arg("supersampling") = 1,
+                " Warning: this constructor can be called only after a valid renderer backend (OpenGL) has been created\n (will call Init())\n If pixelRatio <= 0, ImGui::GetIO().DisplayFramebufferScale.x will be used")
             .def("bind",
                 &NvgImgui::NvgFramebuffer::Bind, "Make the framebuffer the current render target")
             .def("unbind",
-                &NvgImgui::NvgFramebuffer::Unbind, "Restore the previous render target")
+                &NvgImgui::NvgFramebuffer::Unbind, " Restore the previous render target\n (if supersampling is active, this will also resolve the drawing into the texture)")
+            .def("texture_width",
+                &NvgImgui::NvgFramebuffer::TextureWidth, "Size of the texture in pixels")
+            .def("texture_height",
+                &NvgImgui::NvgFramebuffer::TextureHeight)
+            .def("set_pixel_ratio",
+                &NvgImgui::NvgFramebuffer::SetPixelRatio,
+                nb::arg("pixel_ratio"), nb::arg("supersampling") = 1,
+                "Change the pixel ratio and/or supersampling (will reallocate the texture if they changed)")
+            .def("update_resolution_tier",
+                &NvgImgui::NvgFramebuffer::UpdateResolutionTier,
+                nb::arg("displayed_size"),
+                " Select a resolution tier from the size at which the texture is displayed on screen\n (in ImGui coordinates, e.g. the size passed to ImGui::Image).\n Tiers are powers of two (..., 0.5, 1, 2, 4) of the ratio between on-screen pixels and drawing units,\n clamped to [MinPixelRatio, MaxPixelRatio].\n The texture is reallocated only when the tier changes, not on every resize.\n Returns True if the texture was reallocated (in which case it needs to be redrawn).")
             ;
 
 
@@ -989,6 +1006,82 @@ void py_init_module_nanovg(nb::module_& m)
         nvgcpp_ImageSize,
         nb::arg("ctx"), nb::arg("image"),
         "Returns the dimensions of a created image.");
+
+
+    auto pyClassNvgTextStyleKey =
+        nb::class_<NvgTextStyleKey>
+            (m, "NvgTextStyleKey", "The part of the text style that affects the layout")
+        .def("__init__", [](NvgTextStyleKey * self, int fontId = -1, float fontSize = 0.f, float letterSpacing = 0.f, float lineHeight = 1.f, int align = NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE)
+        {
+            new (self) NvgTextStyleKey();  // placement new
+            auto r = self;
+            r->fontId = fontId;
+            r->fontSize = fontSize;
+            r->letterSpacing = letterSpacing;
+            r->lineHeight = lineHeight;
+            r->align = align;
+        },
+        nb::arg("font_id") = -1, nb::arg("font_size") = 0.f, nb::arg("letter_spacing") = 0.f, nb::arg("line_height") = 1.f, nb::arg("align") = NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE
+        )
+        .def_rw("font_id", &NvgTextStyleKey::fontId, "As returned by nvgCreateFont / nvgFindFont")
+        .def_rw("font_size", &NvgTextStyleKey::fontSize, "")
+        .def_rw("letter_spacing", &NvgTextStyleKey::letterSpacing, "")
+        .def_rw("line_height", &NvgTextStyleKey::lineHeight, "Proportional line height (see nvgTextLineHeight)")
+        .def_rw("align", &NvgTextStyleKey::align, "")
+        ;
+
+
+    auto pyClassNvgTextRowSpan =
+        nb::class_<NvgTextRowSpan>
+            (m, "NvgTextRowSpan", "A row of a cached layout, stored as byte offsets inside NvgTextLayout::text (no string copy)")
+        .def(nb::init<>())
+        .def_rw("start", &NvgTextRowSpan::start, "Byte offsets of the row inside the text")
+        .def_rw("end", &NvgTextRowSpan::end, "Byte offsets of the row inside the text")
+        .def_rw("width", &NvgTextRowSpan::width, "Logical width of the row.")
+        .def_rw("minx", &NvgTextRowSpan::minx, "Actual bounds of the row.")
+        .def_rw("maxx", &NvgTextRowSpan::maxx, "Actual bounds of the row.")
+        ;
+
+
+    auto pyClassNvgTextLayout =
+        nb::class_<NvgTextLayout>
+            (m, "NvgTextLayout", "The cached layout of a text")
+        .def_ro("text", &NvgTextLayout::text, "")
+        .def_ro("break_row_width", &NvgTextLayout::breakRowWidth, "")
+        .def_ro("rows", &NvgTextLayout::rows, "")
+        .def_ro("box_bounds", &NvgTextLayout::boxBounds, "Bounds of the text box, when drawn at (0, 0)")
+        .def_ro("lineh", &NvgTextLayout::lineh, "Line height in local coordinate space (see nvgTextMetrics)")
+        ;
+
+
+    auto pyClassNvgTextLayoutCache =
+        nb::class_<NvgTextLayoutCache>
+            (m, "NvgTextLayoutCache", "")
+        .def(nb::init<>())
+        .def_rw("max_unused_frames", &NvgTextLayoutCache::MaxUnusedFrames, "Entries unused for more than MaxUnusedFrames frames are evicted by NewFrame()")
+        .def("layout",
+            &NvgTextLayoutCache::Layout,
+            nb::arg("ctx"), nb::arg("style"), nb::arg("text"), nb::arg("break_row_width"),
+            " Applies the text style to the context, and returns the layout of the text (rows + box bounds),\n computing it on cache misses.\n The returned layout is shared, and stays valid even if the entry is evicted later.")
+        .def("text_box_bounds",
+            &NvgTextLayoutCache::TextBoxBounds,
+            nb::arg("ctx"), nb::arg("style"), nb::arg("x"), nb::arg("y"), nb::arg("break_row_width"), nb::arg("text"),
+            "Same as nvgcpp_TextBoxBounds, using the cached layout")
+        .def("text_box",
+            &NvgTextLayoutCache::TextBox,
+            nb::arg("ctx"), nb::arg("style"), nb::arg("x"), nb::arg("y"), nb::arg("break_row_width"), nb::arg("text"),
+            "Same as nvgcpp_TextBox, using the cached layout (the text is not broken again)")
+        .def("new_frame",
+            &NvgTextLayoutCache::NewFrame, "Call once per frame: evicts unused entries, and resets the per frame counters")
+        .def("clear",
+            &NvgTextLayoutCache::Clear, "Removes all entries (call it when fonts are reloaded)")
+        .def("size",
+            &NvgTextLayoutCache::Size)
+        .def("frame_reuse_count",
+            &NvgTextLayoutCache::FrameReuseCount, "Number of cache hits / misses since the last call to NewFrame()")
+        .def("frame_miss_count",
+            &NvgTextLayoutCache::FrameMissCount)
+        ;
     ////////////////////    </generated_from:nvg_cpp_text.h>    ////////////////////
 
     // </litgen_pydef> // Autogenerated code end
@@ -1,6 +1,11 @@
 #include "nvg_cpp_text.h"
 #include "nanovg.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string_view>
+
 
 float nvgcpp_Text(NVGcontext* ctx, float x, float y, const std::string& text)
 {
@@ -78,3 +83,178 @@ std::tuple<int, int> nvgcpp_ImageSize(NVGcontext* ctx, int image)
     nvgImageSize(ctx, image, &w, &h);
     return std::make_tuple(w, h);
 }
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//                      Text layout cache
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void HashCombine(size_t& seed, size_t v)
+{
+    seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+static size_t HashLayoutKey(const NvgTextStyleKey& style, float fontScale, float breakRowWidth, const std::string& text)
+{
+    size_t h = std::hash<std::string_view>()(std::string_view(text));
+    HashCombine(h, std::hash<float>()(fontScale));
+    HashCombine(h, std::hash<int>()(style.fontId));
+    HashCombine(h, std::hash<float>()(style.fontSize));
+    HashCombine(h, std::hash<float>()(style.letterSpacing));
+    HashCombine(h, std::hash<float>()(style.lineHeight));
+    HashCombine(h, std::hash<int>()(style.align));
+    HashCombine(h, std::hash<float>()(breakRowWidth));
+    return h;
+}
+
+static bool IsSameLayoutKey(
+    const NvgTextStyleKey& style, float fontScale, float breakRowWidth, const std::string& text,
+    const NvgTextStyleKey& otherStyle, float otherFontScale, const NvgTextLayout& otherLayout)
+{
+    return fontScale == otherFontScale
+        && style.fontId == otherStyle.fontId
+        && style.fontSize == otherStyle.fontSize
+        && style.letterSpacing == otherStyle.letterSpacing
+        && style.lineHeight == otherStyle.lineHeight
+        && style.align == otherStyle.align
+        && breakRowWidth == otherLayout.breakRowWidth
+        && text == otherLayout.text;
+}
+
+static void ApplyTextStyle(NVGcontext* ctx, const NvgTextStyleKey& style)
+{
+    nvgFontFaceId(ctx, style.fontId);
+    nvgFontSize(ctx, style.fontSize);
+    nvgTextLetterSpacing(ctx, style.letterSpacing);
+    nvgTextLineHeight(ctx, style.lineHeight);
+    nvgTextAlign(ctx, style.align);
+}
+
+// Same as nvg__getFontScale (nanovg.c): the text is laid out at this scale of the current transform
+static float CurrentFontScale(NVGcontext* ctx)
+{
+    float xform[6];
+    nvgCurrentTransform(ctx, xform);
+    float sx = std::sqrt(xform[0] * xform[0] + xform[2] * xform[2]);
+    float sy = std::sqrt(xform[1] * xform[1] + xform[3] * xform[3]);
+    float averageScale = (sx + sy) * 0.5f;
+    return std::min(std::round(averageScale / 0.01f) * 0.01f, 4.0f);
+}
+
+static std::shared_ptr<NvgTextLayout> ComputeLayout(NVGcontext* ctx, const std::string& text, float breakRowWidth)
+{
+    auto layout = std::make_shared<NvgTextLayout>();
+    layout->text = text;
+    layout->breakRowWidth = breakRowWidth;
+
+    const char* textStart = layout->text.c_str();
+    const char* textEnd = textStart + layout->text.size();
+
+    // Break by chunks, so that the number of rows is not limited
+    constexpr int chunkSize = 64;
+    NVGtextRow rows[chunkSize];
+    const char* current = textStart;
+    int nbRows;
+    while ((nbRows = nvgTextBreakLines(ctx, current, textEnd, breakRowWidth, rows, chunkSize)) > 0)
+    {
+        for (int i = 0; i < nbRows; ++i)
+        {
+            NvgTextRowSpan span;
+            span.start = (int)(rows[i].start - textStart);
+            span.end = (int)(rows[i].end - textStart);
+            span.width = rows[i].width;
+            span.minx = rows[i].minx;
+            span.maxx = rows[i].maxx;
+            layout->rows.push_back(span);
+        }
+        current = rows[nbRows - 1].next;
+    }
+
+    nvgTextBoxBounds(ctx, 0.f, 0.f, breakRowWidth, textStart, textEnd, layout->boxBounds.data());
+    nvgTextMetrics(ctx, nullptr, nullptr, &layout->lineh);
+    return layout;
+}
+
+std::shared_ptr<const NvgTextLayout> NvgTextLayoutCache::Layout(
+    NVGcontext* ctx, const NvgTextStyleKey& style, const std::string& text, float breakRowWidth)
+{
+    ApplyTextStyle(ctx, style);
+    float fontScale = CurrentFontScale(ctx);
+    size_t hash = HashLayoutKey(style, fontScale, breakRowWidth, text);
+    auto range = mEntries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        Entry& entry = it->second;
+        if (IsSameLayoutKey(style, fontScale, breakRowWidth, text, entry.style, entry.fontScale, *entry.layout))
+        {
+            entry.lastUsedFrame = mFrameIdx;
+            ++mFrameReuseCount;
+            return entry.layout;
+        }
+    }
+
+    ++mFrameMissCount;
+    Entry entry;
+    entry.style = style;
+    entry.fontScale = fontScale;
+    entry.layout = ComputeLayout(ctx, text, breakRowWidth);
+    entry.lastUsedFrame = mFrameIdx;
+    mEntries.emplace(hash, entry);
+    return entry.layout;
+}
+
+Bounds NvgTextLayoutCache::TextBoxBounds(
+    NVGcontext* ctx, const NvgTextStyleKey& style, float x, float y, float breakRowWidth, const std::string& text)
+{
+    // The box bounds are cached for a text drawn at (0, 0): translate them
+    Bounds bounds = Layout(ctx, style, text, breakRowWidth)->boxBounds;
+    bounds[0] += x; bounds[1] += y;
+    bounds[2] += x; bounds[3] += y;
+    return bounds;
+}
+
+void NvgTextLayoutCache::TextBox(
+    NVGcontext* ctx, const NvgTextStyleKey& style, float x, float y, float breakRowWidth, const std::string& text)
+{
+    // Mimics nvgTextBox, using the cached rows
+    auto layout = Layout(ctx, style, text, breakRowWidth);
+    const char* textStart = layout->text.c_str();
+
+    int halign = style.align & (NVG_ALIGN_LEFT | NVG_ALIGN_CENTER | NVG_ALIGN_RIGHT);
+    int valign = style.align & (NVG_ALIGN_TOP | NVG_ALIGN_MIDDLE | NVG_ALIGN_BOTTOM | NVG_ALIGN_BASELINE);
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | valign);
+    for (const NvgTextRowSpan& row : layout->rows)
+    {
+        const char* rowStart = textStart + row.start;
+        const char* rowEnd = textStart + row.end;
+        if (halign & NVG_ALIGN_LEFT)
+            nvgText(ctx, x, y, rowStart, rowEnd);
+        else if (halign & NVG_ALIGN_CENTER)
+            nvgText(ctx, x + breakRowWidth * 0.5f - row.width * 0.5f, y, rowStart, rowEnd);
+        else if (halign & NVG_ALIGN_RIGHT)
+            nvgText(ctx, x + breakRowWidth - row.width, y, rowStart, rowEnd);
+        y += layout->lineh * style.lineHeight;
+    }
+    nvgTextAlign(ctx, style.align);
+}
+
+void NvgTextLayoutCache::NewFrame()
+{
+    ++mFrameIdx;
+    mFrameReuseCount = 0;
+    mFrameMissCount = 0;
+    for (auto it = mEntries.begin(); it != mEntries.end(); )
+    {
+        if (mFrameIdx - it->second.lastUsedFrame > MaxUnusedFrames)
+            it = mEntries.erase(it);
+        else
+            ++it;
+    }
+}
+
+void NvgTextLayoutCache::Clear()
+{
+    mEntries.clear();
+    mFrameReuseCount = 0;
+    mFrameMissCount = 0;
+}
@@ -5,6 +5,8 @@
 #include <array>
 #include <tuple>
 #include <vector>
+#include <memory>
+#include <unordered_map>
 
 
 // C++ Wrappers to NanoVG text functions, to simplify python bindings
@@ -69,3 +71,92 @@ void nvgcpp_TextLineHeight(NVGcontext* ctx, float lineHeight);
 
 // Returns the dimensions of a created image.
 std::tuple<int, int> nvgcpp_ImageSize(NVGcontext* ctx, int image);
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//                      Text layout cache
+// ---------------------------------------------------------------------------------------------------------------------
+// NvgTextLayoutCache caches the result of TextBreakLines and TextBoxBounds for texts that are drawn
+// at each frame (e.g. chart ticks and annotations).
+// Entries are keyed by (text style, scale of the current transform, break width, text),
+// and evicted when unused for MaxUnusedFrames frames.
+//
+// The text style is applied to the context by each call (nvgFontFaceId, nvgFontSize, nvgTextLetterSpacing,
+// nvgTextLineHeight and nvgTextAlign), and stays set afterward.
+// Call Clear() if the device pixel ratio passed to nvgBeginFrame changes.
+
+
+// The part of the text style that affects the layout
+struct NvgTextStyleKey
+{
+    int fontId = -1;            // As returned by nvgCreateFont / nvgFindFont
+    float fontSize = 0.f;
+    float letterSpacing = 0.f;
+    float lineHeight = 1.f;     // Proportional line height (see nvgTextLineHeight)
+    int align = NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE;
+};
+
+
+// A row of a cached layout, stored as byte offsets inside NvgTextLayout::text (no string copy)
+struct NvgTextRowSpan
+{
+    int start = 0, end = 0;     // Byte offsets of the row inside the text
+    float width = 0.f;          // Logical width of the row.
+    float minx = 0.f, maxx = 0.f;   // Actual bounds of the row.
+};
+
+
+// The cached layout of a text
+struct NvgTextLayout
+{
+    std::string text;
+    float breakRowWidth = 0.f;
+    std::vector<NvgTextRowSpan> rows;
+    Bounds boxBounds = {};      // Bounds of the text box, when drawn at (0, 0)
+    float lineh = 0.f;          // Line height in local coordinate space (see nvgTextMetrics)
+};
+
+
+class NvgTextLayoutCache
+{
+public:
+    // Entries unused for more than MaxUnusedFrames frames are evicted by NewFrame()
+    int MaxUnusedFrames = 60;
+
+    // Applies the text style to the context, and returns the layout of the text (rows + box bounds),
+    // computing it on cache misses.
+    // The returned layout is shared, and stays valid even if the entry is evicted later.
+    std::shared_ptr<const NvgTextLayout> Layout(
+        NVGcontext* ctx, const NvgTextStyleKey& style, const std::string& text, float breakRowWidth);
+
+    // Same as nvgcpp_TextBoxBounds, using the cached layout
+    Bounds TextBoxBounds(
+        NVGcontext* ctx, const NvgTextStyleKey& style, float x, float y, float breakRowWidth, const std::string& text);
+
+    // Same as nvgcpp_TextBox, using the cached layout (the text is not broken again)
+    void TextBox(
+        NVGcontext* ctx, const NvgTextStyleKey& style, float x, float y, float breakRowWidth, const std::string& text);
+
+    // Call once per frame: evicts unused entries, and resets the per frame counters
+    void NewFrame();
+
+    // Removes all entries (call it when fonts are reloaded)
+    void Clear();
+
+    size_t Size() const { return mEntries.size(); }
+    // Number of cache hits / misses since the last call to NewFrame()
+    int FrameReuseCount() const { return mFrameReuseCount; }
+    int FrameMissCount() const { return mFrameMissCount; }
+
+private:
+    struct Entry
+    {
+        NvgTextStyleKey style;
+        float fontScale = 1.f;      // Scale of the current transform (it changes the glyph metrics)
+        std::shared_ptr<NvgTextLayout> layout;
+        int lastUsedFrame = 0;
+    };
+    std::unordered_multimap<size_t, Entry> mEntries;  // keyed by a hash of (style, fontScale, breakRowWidth, text)
+    int mFrameIdx = 0;
+    int mFrameReuseCount = 0, mFrameMissCount = 0;
+};
@@ -3,6 +3,7 @@
 
 #include "nanovg.h"
 #include "imgui.h"
+#include <algorithm>
 
 #ifdef HAS_NVG_OPENGL
     #include "hello_imgui/hello_imgui_include_opengl.h"
@@ -31,7 +32,8 @@ namespace NvgImgui
 {
     struct NvgFramebuffer::PImpl
     {
-        NVGLUframebuffer *fb = nullptr;
+        NVGLUframebuffer *fb = nullptr;          // Render target (supersampled if _parent->Supersampling > 1)
+        NVGLUframebuffer *fbResolved = nullptr;  // Resolve target, only used if _parent->Supersampling > 1
         GLint defaultViewport[4];  // To store the default viewport dimensions
         NvgFramebuffer *_parent = nullptr;
 
@@ -49,9 +51,17 @@ namespace NvgImgui
         {
             if (_parent->vg == nullptr)
                 return;
-            fb = nvgluCreateFramebuffer(_parent->vg, _parent->Width, _parent->Height, _parent->NvgImageFlags);
+            int w = _parent->TextureWidth(), h = _parent->TextureHeight(), ss = _parent->Supersampling;
+            fb = nvgluCreateFramebuffer(_parent->vg, w * ss, h * ss, _parent->NvgImageFlags);
             IM_ASSERT(fb && "Failed to create NVGLU framebuffer");
-            _parent->TextureId = (ImTextureID) (intptr_t) fb->texture;
+            if (ss > 1)
+            {
+                fbResolved = nvgluCreateFramebuffer(_parent->vg, w, h, _parent->NvgImageFlags);
+                IM_ASSERT(fbResolved && "Failed to create NVGLU resolve framebuffer");
+                _parent->TextureId = (ImTextureID) (intptr_t) fbResolved->texture;
+            }
+            else
+                _parent->TextureId = (ImTextureID) (intptr_t) fb->texture;
         }
 
         void ReleaseResource()
@@ -61,17 +71,32 @@ namespace NvgImgui
                 nvgluDeleteFramebuffer(fb);
                 fb = nullptr;
             }
+            if (fbResolved)
+            {
+                nvgluDeleteFramebuffer(fbResolved);
+                fbResolved = nullptr;
+            }
+            _parent->TextureId = {};
         }
 
         void Bind()
         {
+            int ss = _parent->Supersampling;
             nvgluBindFramebuffer(fb);
             glGetIntegerv(GL_VIEWPORT, defaultViewport);
-            glViewport(0, 0, _parent->Width, _parent->Height);
+            glViewport(0, 0, _parent->TextureWidth() * ss, _parent->TextureHeight() * ss);
         }
 
         void Unbind()
         {
+            if (fbResolved)
+            {
+                // Resolve: downscale the supersampled drawing into the texture
+                int w = _parent->TextureWidth(), h = _parent->TextureHeight(), ss = _parent->Supersampling;
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, fb->fbo);
+                glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbResolved->fbo);
+                glBlitFramebuffer(0, 0, w * ss, h * ss, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+            }
             nvgluBindFramebuffer(nullptr);
             glViewport(defaultViewport[0], defaultViewport[1], defaultViewport[2], defaultViewport[3]);
         }
@@ -127,7 +152,11 @@ namespace NvgImgui
         {
             if (_parent->vg == nullptr)
                 return;
-            fb = mnvgCreateFramebuffer(_parent->vg, _parent->Width, _parent->Height, _parent->NvgImageFlags);
+            // Note: there is no separate resolve step with Metal: when supersampling, the texture is
+            // larger than needed, and is downscaled by the ImGui sampler when displayed.
+            int ss = _parent->Supersampling;
+            fb = mnvgCreateFramebuffer(
+                _parent->vg, _parent->TextureWidth() * ss, _parent->TextureHeight() * ss, _parent->NvgImageFlags);
             IM_ASSERT(fb && "Failed to create NVGLU framebuffer");
             _parent->TextureId = (ImTextureID)(intptr_t)mnvgImageHandle(_parent->vg, fb->image);
         }
@@ -139,6 +168,7 @@ namespace NvgImgui
                 mnvgDeleteFramebuffer(fb);
                 fb = nullptr;
             }
+            _parent->TextureId = {};
         }
 
         void Bind()
@@ -167,9 +197,17 @@ namespace NvgImgui
 
 namespace NvgImgui
 {
-    NvgFramebuffer::NvgFramebuffer(NVGcontext* vg, int width, int height, int nvgImageFlags) // See NVGimageFlags
+    static float DefaultPixelRatio()
+    {
+        float r = ImGui::GetIO().DisplayFramebufferScale.x;
+        return r > 0.f ? r : 1.f;
+    }
+
+    NvgFramebuffer::NvgFramebuffer(NVGcontext* vg, int width, int height, int nvgImageFlags, float pixelRatio, int supersampling)
         : vg(vg), Width(width), Height(height), NvgImageFlags(nvgImageFlags)
     {
+        PixelRatio = pixelRatio > 0.f ? pixelRatio : DefaultPixelRatio();
+        Supersampling = std::max(supersampling, 1);
         pImpl = new PImpl(this);
     }
 
@@ -178,6 +216,45 @@ namespace NvgImgui
     void NvgFramebuffer::Bind() { pImpl->Bind(); }
     void NvgFramebuffer::Unbind() { pImpl->Unbind(); }
 
+    int NvgFramebuffer::TextureWidth() const { return std::max((int)((float)Width * PixelRatio + 0.5f), 1); }
+    int NvgFramebuffer::TextureHeight() const { return std::max((int)((float)Height * PixelRatio + 0.5f), 1); }
+
+    void NvgFramebuffer::SetPixelRatio(float pixelRatio, int supersampling)
+    {
+        supersampling = std::max(supersampling, 1);
+        if (pixelRatio <= 0.f)
+            pixelRatio = DefaultPixelRatio();
+        if (pixelRatio == PixelRatio && supersampling == Supersampling)
+            return;
+        pImpl->ReleaseResource();
+        PixelRatio = pixelRatio;
+        Supersampling = supersampling;
+        pImpl->AcquireResource();
+    }
+
+    bool NvgFramebuffer::UpdateResolutionTier(ImVec2 displayedSize)
+    {
+        if (Width <= 0 || Height <= 0 || displayedSize.x <= 0.f || displayedSize.y <= 0.f)
+            return false;
+
+        // Number of on-screen pixels per drawing unit
+        float wantedRatio = std::max(displayedSize.x / (float)Width, displayedSize.y / (float)Height) * DefaultPixelRatio();
+
+        float tier = MinPixelRatio;
+        while (tier < wantedRatio && tier < MaxPixelRatio)
+            tier *= 2.f;
+        tier = std::min(tier, MaxPixelRatio);
+
+        if (tier == PixelRatio)
+            return false;
+        // Hysteresis: do not go down one tier as soon as the widget becomes slightly smaller
+        if (tier < PixelRatio && wantedRatio > PixelRatio * 0.4f)
+            return false;
+
+        SetPixelRatio(tier, Supersampling);
+        return true;
+    }
+
 
     void RenderNvgToBackground(NVGcontext* vg, NvgDrawingFunction nvgDrawingFunction, ImVec4 clearColor)
     {
@@ -204,15 +281,9 @@ namespace NvgImgui
         if (clearColor.w > 0.f)
             FillClearColor(vg, clearColor);
 
-        // Note:
-        //    - internally, we use NVGLUframebuffer, provided by NanoVG
-        //    - NVGLUframebuffer does not handle pixelRatio
-        //    => using pixelRatio=DisplayFramebufferScale would lead to non anti-aliased rendering
-        //    => you may want to create texture of bigger size and scale down the drawing, in order to
-        //       improve the quality of the rendering
-
-        // float pixelRatio = ImGui::GetIO().DisplayFramebufferScale.x;
-        float pixelRatio = 1.f;
+        // The framebuffer is allocated at TextureWidth() * Supersampling pixels,
+        // so that we can draw in drawing units (Width x Height) with the matching pixel ratio
+        float pixelRatio = texture.PixelRatio * (float)texture.Supersampling;
         nvgBeginFrame(vg, texture.Width, texture.Height, pixelRatio);
 
 #ifdef HAS_NVG_OPENGL
@@ -69,6 +69,12 @@ namespace NvgImgui
     // NvgFramebuffer: a framebuffer that can be used by NanoVG + ImGui
     // Internally stored inside the renderer backend (e.g. OpenGL)
     // Note: this class can be instantiated only after a valid renderer backend (OpenGL) has been created
+    //
+    // Width and Height are expressed in drawing units: this is the size that NanoVG drawing functions see.
+    // The texture is allocated at Width * PixelRatio x Height * PixelRatio pixels, where PixelRatio defaults
+    // to ImGui::GetIO().DisplayFramebufferScale (so that the drawing is crisp on HiDPI screens).
+    // If Supersampling > 1, the drawing is rendered at Supersampling times this resolution, and then resolved
+    // (i.e. downscaled) into the texture.
     class NvgFramebuffer
     {
     public:
@@ -77,13 +83,26 @@ namespace NvgImgui
         int NvgImageFlags = 0;
         ImTextureID TextureId = {};
 
+        // Ratio between texture pixels and drawing units (read-only: use SetPixelRatio or UpdateResolutionTier)
+        float PixelRatio = 1.f;
+        // Supersampling factor (1 = no supersampling, 2 = render at 2x2 resolution then resolve, etc.)
+        // (read-only: use SetPixelRatio)
+        int Supersampling = 1;
+
+        // Bounds for the pixel ratio selected by UpdateResolutionTier
+        float MinPixelRatio = 0.25f;
+        float MaxPixelRatio = 4.f;
+
         // Warning: this constructor can be called only after a valid renderer backend (OpenGL) has been created
         // (will call Init())
+        // If pixelRatio <= 0, ImGui::GetIO().DisplayFramebufferScale.x will be used
         NvgFramebuffer(
             NVGcontext *vg,
             int width, int height,
-            int nvgImageFlags
-            ); // See NVGimageFlags
+            int nvgImageFlags,  // See NVGimageFlags
+            float pixelRatio = -1.f,
+            int supersampling = 1
+            );
 
         // Warning: this destructor should be called when a valid render backend (e.g. OpenGL) is still active
         // and when the NVGcontext vg is still valid
@@ -93,8 +112,24 @@ namespace NvgImgui
         void Bind();
 
         // Restore the previous render target
+        // (if supersampling is active, this will also resolve the drawing into the texture)
         void Unbind();
 
+        // Size of the texture in pixels
+        int TextureWidth() const;
+        int TextureHeight() const;
+
+        // Change the pixel ratio and/or supersampling (will reallocate the texture if they changed)
+        void SetPixelRatio(float pixelRatio, int supersampling = 1);
+
+        // Select a resolution tier from the size at which the texture is displayed on screen
+        // (in ImGui coordinates, e.g. the size passed to ImGui::Image).
+        // Tiers are powers of two (..., 0.5, 1, 2, 4) of the ratio between on-screen pixels and drawing units,
+        // clamped to [MinPixelRatio, MaxPixelRatio].
+        // The texture is reallocated only when the tier changes, not on every resize.
+        // Returns true if the texture was reallocated (in which case it needs to be redrawn).
+        bool UpdateResolutionTier(ImVec2 displayedSize);
+
     private:
         // PImpl that contains the actual implementation of the framebuffer, depending on the rendering backend
         struct PImpl;
@@ -67,6 +67,9 @@ namespace pfd
 
         bool ready(int timeout = default_wait_timeout) const;
         bool kill() const;
+        // Register a callback that is invoked once when the dialog completes
+        // (it is called from ready() or result(), on the thread that polls the dialog)
+        void on_ready(std::function<void()> const& callback) const;
     };
 
     //
@@ -84,6 +87,9 @@ namespace pfd
 
         bool ready(int timeout = default_wait_timeout) const;
         bool kill() const;
+        // Register a callback that is invoked once when the dialog completes
+        // (it is called from ready() or result(), on the thread that polls the dialog)
+        void on_ready(std::function<void()> const& callback) const;
     };
 
     std::vector<std::string> all_files_filter() {
@@ -103,6 +109,9 @@ namespace pfd
 
         bool ready(int timeout = default_wait_timeout) const;
         bool kill() const;
+        // Register a callback that is invoked once when the dialog completes
+        // (it is called from ready() or result(), on the thread that polls the dialog)
+        void on_ready(std::function<void()> const& callback) const;
 
         std::vector<std::string> result();
     };
@@ -117,6 +126,9 @@ namespace pfd
 
         bool ready(int timeout = default_wait_timeout) const;
         bool kill() const;
+        // Register a callback that is invoked once when the dialog completes
+        // (it is called from ready() or result(), on the thread that polls the dialog)
+        void on_ready(std::function<void()> const& callback) const;
 
         std::string result();
     };
@@ -130,6 +142,9 @@ namespace pfd
 
         bool ready(int timeout = default_wait_timeout) const;
         bool kill() const;
+        // Register a callback that is invoked once when the dialog completes
+        // (it is called from ready() or result(), on the thread that polls the dialog)
+        void on_ready(std::function<void()> const& callback) const;
 
         std::string result();
     };
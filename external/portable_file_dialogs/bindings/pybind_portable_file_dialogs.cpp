@@ -78,6 +78,8 @@ void py_init_module_portable_file_dialogs(nb::module_& m)
             &pfd::notify::ready, nb::arg("timeout") = default_wait_timeout)
         .def("kill",
             &pfd::notify::kill)
+        .def("on_ready",
+            &pfd::notify::on_ready, nb::arg("callback"), " Register a callback that is invoked once when the dialog completes\n (it is called from ready() or result(), on the thread that polls the dialog;\n it is not called if the dialog is destroyed before completing)")
         ;
 
 
@@ -92,6 +94,8 @@ void py_init_module_portable_file_dialogs(nb::module_& m)
             &pfd::message::ready, nb::arg("timeout") = default_wait_timeout)
         .def("kill",
             &pfd::message::kill)
+        .def("on_ready",
+            &pfd::message::on_ready, nb::arg("callback"), " Register a callback that is invoked once when the dialog completes\n (it is called from ready() or result(), on the thread that polls the dialog;\n it is not called if the dialog is destroyed before completing)")
         ;
 
 
@@ -130,6 +134,8 @@ void py_init_module_portable_file_dialogs(nb::module_& m)
             &pfd::open_file::ready, nb::arg("timeout") = default_wait_timeout)
         .def("kill",
             &pfd::open_file::kill)
+        .def("on_ready",
+            &pfd::open_file::on_ready, nb::arg("callback"), " Register a callback that is invoked once when the dialog completes\n (it is called from ready() or result(), on the thread that polls the dialog;\n it is not called if the dialog is destroyed before completing)")
         .def("result",
             &pfd::open_file::result)
         ;
@@ -166,6 +172,8 @@ void py_init_module_portable_file_dialogs(nb::module_& m)
             &pfd::save_file::ready, nb::arg("timeout") = default_wait_timeout)
         .def("kill",
             &pfd::save_file::kill)
+        .def("on_ready",
+            &pfd::save_file::on_ready, nb::arg("callback"), " Register a callback that is invoked once when the dialog completes\n (it is called from ready() or result(), on the thread that polls the dialog;\n it is not called if the dialog is destroyed before completing)")
         .def("result",
             &pfd::save_file::result)
         ;
@@ -180,6 +188,8 @@ void py_init_module_portable_file_dialogs(nb::module_& m)
             &pfd::select_folder::ready, nb::arg("timeout") = default_wait_timeout)
         .def("kill",
             &pfd::select_folder::kill)
+        .def("on_ready",
+            &pfd::select_folder::on_ready, nb::arg("callback"), " Register a callback that is invoked once when the dialog completes\n (it is called from ready() or result(), on the thread that polls the dialog;\n it is not called if the dialog is destroyed before completing)")
         .def("result",
             &pfd::select_folder::result)
         ;
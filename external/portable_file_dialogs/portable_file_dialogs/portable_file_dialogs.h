@@ -41,11 +41,15 @@
 #include <cstdio>     // popen()
 #include <cstdlib>    // std::getenv()
 #include <fcntl.h>    // fcntl()
+#include <poll.h>     // poll()
 #include <unistd.h>   // read(), pipe(), dup2(), getuid()
 #include <csignal>    // ::kill, std::signal
 #include <sys/stat.h> // stat()
 #include <sys/wait.h> // waitpid()
 #include <pwd.h>      // getpwnam()
+#if __linux__
+#include <sys/syscall.h> // SYS_pidfd_open
+#endif
 #endif
 
 #include <string>   // std::string
@@ -56,6 +60,7 @@
 #include <regex>    // std::regex
 #include <thread>   // std::mutex, std::this_thread
 #include <chrono>   // std::chrono
+#include <functional> // std::function
 
 // Versions of mingw64 g++ up to 9.3.0 do not have a complete IFileDialog
 #ifndef PFD_HAS_IFILEDIALOG
@@ -161,8 +166,10 @@ namespace pfd
     namespace internal
     {
 
-        // Process wait timeout, in milliseconds
-        static int const default_wait_timeout = 20;
+        // Process wait timeout, in milliseconds. By default, ready() only checks
+        // for completion and never blocks the caller: use a positive value to
+        // wait at most this duration, or -1 to wait until the process completes.
+        static int const default_wait_timeout = 0;
 
         class executor
         {
@@ -194,6 +201,7 @@ namespace pfd
             bool m_running = false;
             std::string m_stdout;
             int m_exit_code = -1;
+            std::function<void()> m_on_ready;
 #if _WIN32
             std::future<std::string> m_future;
             std::set<HWND> m_windows;
@@ -205,6 +213,7 @@ namespace pfd
 #else
             pid_t m_pid = 0;
             int m_fd = -1;
+            int m_pidfd = -1; // Linux >= 5.3 only, becomes readable when the child exits
 #endif
         };
 
@@ -270,6 +279,12 @@ namespace pfd
             bool kill() const;
             virtual ~dialog() = default;
 
+            // Register a callback that is invoked once when the dialog completes.
+            // It is called from ready() or result(), so that it runs on the thread
+            // that polls the dialog (e.g. the UI thread). It is not called if the
+            // dialog is destroyed before completing.
+            void on_ready(std::function<void()> const& callback) const;
+
         protected:
             explicit dialog();
 
@@ -585,7 +600,10 @@ namespace pfd
         settings(/* resync = */ true);
     }
 
-    // Check whether a program is present using “which”.
+    // Check whether a program is present in the PATH. This uses access() on each
+    // PATH entry rather than spawning “which”, so that scanning for the desktop
+    // helpers does not fork any process. Results are cached process-wide in the
+    // settings flags, until rescan() is called.
     inline bool settings::check_program(std::string const& program)
     {
 #if _WIN32
@@ -595,11 +613,30 @@ namespace pfd
         (void)program;
         return false;
 #else
-        int exit_code = -1;
-        internal::executor async;
-        async.start_process({ "/bin/sh", "-c", "which " + program });
-        async.result(&exit_code);
-        return exit_code == 0;
+        auto is_executable = [](std::string const& file)
+        {
+            struct stat s;
+            return access(file.c_str(), X_OK) == 0 && stat(file.c_str(), &s) == 0 && S_ISREG(s.st_mode);
+        };
+
+        if (program.find('/') != std::string::npos)
+            return is_executable(program);
+
+        auto path = internal::getenv("PATH");
+        size_t start = 0;
+        while (start <= path.size())
+        {
+            auto end = path.find(':', start);
+            if (end == std::string::npos)
+                end = path.size();
+            auto dir = path.substr(start, end - start);
+            if (dir.empty())
+                dir = "."; // An empty PATH entry means the current directory
+            if (is_executable(dir + "/" + program))
+                return true;
+            start = end + 1;
+        }
+        return false;
 #endif
     }
 
@@ -804,12 +841,20 @@ namespace pfd
         auto flags = fcntl(m_fd, F_GETFL);
         fcntl(m_fd, F_SETFL, flags | O_NONBLOCK);
 
+#if __linux__ && defined(SYS_pidfd_open)
+        // Also watch the process itself, in case its stdout is kept open by a grandchild
+        m_pidfd = (int)syscall(SYS_pidfd_open, m_pid, 0);
+#endif
+
         m_running = true;
     }
 #endif
 
     inline internal::executor::~executor()
     {
+        // stop() completes the dialog through ready(): the callback must not run
+        // from the destructor, since the objects it captures may already be gone
+        m_on_ready = nullptr;
         stop();
     }
 
@@ -842,40 +887,72 @@ namespace pfd
         // FIXME: do something
         (void)timeout;
 #else
-        char buf[BUFSIZ];
-        ssize_t received = read(m_fd, buf, BUFSIZ); // Flawfinder: ignore
-        if (received > 0)
+        // Wait for new output or for the child to exit. With timeout == 0 this
+        // only checks for pending events, and never sleeps on the caller.
+        struct pollfd fds[2] = { { m_fd, POLLIN, 0 }, { m_pidfd, POLLIN, 0 } };
+        nfds_t nfds = m_pidfd >= 0 ? 2 : 1;
+        if (poll(fds, nfds, timeout) < 0)
+            return false; // EINTR: the caller will poll again
+
+        // Drain the available output
+        bool eof = false;
+        for (;;)
         {
-            m_stdout += std::string(buf, received);
-            return false;
+            char buf[BUFSIZ];
+            ssize_t received = read(m_fd, buf, BUFSIZ); // Flawfinder: ignore
+            if (received > 0)
+                m_stdout += std::string(buf, received);
+            else
+            {
+                eof = received == 0;
+                break; // EOF, or EAGAIN when no more data is available yet
+            }
         }
 
+        bool exited = eof || (nfds == 2 && (fds[1].revents & POLLIN));
+        if (!exited)
+            return false;
+
         // Reap child process if it is dead. It is possible that the system has already reaped it
         // (this happens when the calling application handles or ignores SIG_CHLD) and results in
-        // waitpid() failing with ECHILD. Otherwise we assume the child is running and we sleep for
-        // a little while.
-        int status;
-        pid_t child = waitpid(m_pid, &status, WNOHANG);
+        // waitpid() failing with ECHILD. Only block in waitpid() if the caller asked to wait
+        // until completion, since the child may close its stdout slightly before exiting.
+        int status = 0;
+        pid_t child = waitpid(m_pid, &status, timeout < 0 ? 0 : WNOHANG);
         if (child != m_pid && (child >= 0 || errno != ECHILD))
-        {
-            // FIXME: this happens almost always at first iteration
-            std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
             return false;
-        }
 
         close(m_fd);
+        m_fd = -1;
+        if (m_pidfd >= 0)
+        {
+            close(m_pidfd);
+            m_pidfd = -1;
+        }
         m_exit_code = WEXITSTATUS(status);
 #endif
 
         m_running = false;
+        if (m_on_ready)
+        {
+            auto on_ready = std::move(m_on_ready);
+            m_on_ready = nullptr;
+            on_ready();
+        }
         return true;
     }
 
     inline void internal::executor::stop()
     {
         // Loop until the user closes the dialog
-        while (!ready())
+#if _WIN32
+        // Wake up regularly, so that ready() can run the message pump
+        while (!ready(20))
+            ;
+#else
+        while (!ready(-1))
             ;
+#endif
     }
 
     // dll implementation
@@ -974,6 +1051,14 @@ namespace pfd
         return m_async->kill();
     }
 
+    inline void internal::dialog::on_ready(std::function<void()> const& callback) const
+    {
+        if (m_async->m_running)
+            m_async->m_on_ready = callback;
+        else if (callback)
+            callback();
+    }
+
     inline internal::dialog::dialog()
         : m_async(std::make_shared<executor>())
     {
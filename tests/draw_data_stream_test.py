@@ -0,0 +1,137 @@
+# Part of ImGui Bundle - MIT License - Copyright (c) 2022-2023 Pascal Thomet - https://github.com/pthom/imgui_bundle
+
+# Checks the draw data stream codec: round trip (key frames, references, deltas), rejection of corrupted packets,
+# and the loopback client. The frames are produced by a headless ImGui context (no window, no renderer).
+import random
+import sys
+
+
+POSITION_TOLERANCE = 1.0 / 32.0  # positions are rounded to 1/16 pixel
+UV_TOLERANCE = 1.0 / 65535.0
+
+
+def render_frame(imgui, counter: int, moving_window_x: float):
+    from imgui_bundle import ImVec2
+
+    imgui.new_frame()
+    imgui.set_next_window_pos(ImVec2(moving_window_x, 20.0))
+    imgui.begin("Moving window")
+    imgui.text("This window moves")
+    imgui.end()
+    imgui.set_next_window_pos(ImVec2(300.0, 200.0))
+    imgui.begin("Counter window")
+    imgui.text(f"Counter: {counter}")
+    imgui.text("Some text after the counter")
+    imgui.end()
+    imgui.render()
+    return imgui.get_draw_data()
+
+
+def assert_same_draw_data(decoder, draw_data):
+    assert len(decoder.draw_lists) == draw_data.cmd_lists_count
+    for decoded, draw_list in zip(decoder.draw_lists, draw_data.cmd_lists):
+        vertices = list(draw_list.vtx_buffer)
+        assert len(decoded.vtx_buffer) == len(vertices)
+        for a, b in zip(decoded.vtx_buffer, vertices):
+            assert abs(a.pos.x - b.pos.x) <= POSITION_TOLERANCE and abs(a.pos.y - b.pos.y) <= POSITION_TOLERANCE
+            assert abs(a.uv.x - b.uv.x) <= UV_TOLERANCE and abs(a.uv.y - b.uv.y) <= UV_TOLERANCE
+            assert a.col == b.col
+        assert decoded.idx_buffer == list(draw_list.idx_buffer)
+        commands = [cmd for cmd in draw_list.cmd_buffer if cmd.elem_count > 0]
+        assert [cmd.elem_count for cmd in decoded.cmd_buffer] == [cmd.elem_count for cmd in commands]
+        assert [cmd.idx_offset for cmd in decoded.cmd_buffer] == [cmd.idx_offset for cmd in commands]
+
+
+def init_headless_context(imgui):
+    from imgui_bundle import ImVec2
+
+    io = imgui.get_io()
+    io.set_ini_filename("")
+    io.display_size = ImVec2(800.0, 600.0)
+    io.delta_time = 1.0 / 60.0
+    io.fonts.build()
+    # New windows are auto-fitted during their first frames
+    for _ in range(3):
+        render_frame(imgui, 0, 20.0)
+
+
+def test_draw_data_stream():
+    if sys.platform == "win32":
+        return
+
+    from imgui_bundle import imgui, immapp
+
+    ctx = imgui.create_context()
+    try:
+        init_headless_context(imgui)
+
+        encoder = immapp.DrawDataStreamEncoder()
+        decoder = immapp.DrawDataStreamDecoder()
+
+        # Key frame
+        key_packet = encoder.encode_frame(render_frame(imgui, 0, 20.0))
+        assert decoder.decode_frame(key_packet)
+        assert_same_draw_data(decoder, imgui.get_draw_data())
+
+        # Same frame: all the lists are sent as references
+        packet = encoder.encode_frame(render_frame(imgui, 0, 20.0))
+        assert len(packet) < len(key_packet) / 10
+        assert decoder.decode_frame(packet)
+        assert_same_draw_data(decoder, imgui.get_draw_data())
+
+        # A window moves (reference + translation), the counter changes (delta)
+        packet = encoder.encode_frame(render_frame(imgui, 1234, 60.0))
+        assert len(packet) < len(key_packet) / 2
+        assert decoder.decode_frame(packet)
+        assert_same_draw_data(decoder, imgui.get_draw_data())
+
+        # Corrupted packets are rejected, or decoded into valid commands
+        packet = immapp.DrawDataStreamEncoder().encode_frame(imgui.get_draw_data())
+        for size in range(len(packet)):
+            assert not immapp.DrawDataStreamDecoder().decode_frame(packet[:size])
+        rng = random.Random(0)
+        for _ in range(200):
+            corrupted = bytearray(packet)
+            corrupted[rng.randrange(len(corrupted))] ^= 1 << rng.randrange(8)
+            corrupted_decoder = immapp.DrawDataStreamDecoder()
+            if corrupted_decoder.decode_frame(bytes(corrupted)):
+                for decoded in corrupted_decoder.draw_lists:
+                    for cmd in decoded.cmd_buffer:
+                        indices = decoded.idx_buffer[cmd.idx_offset : cmd.idx_offset + cmd.elem_count]
+                        assert all(cmd.vtx_offset + idx < len(decoded.vtx_buffer) for idx in indices)
+
+        # After a lost packet, the packets which refer to the previous frame are rejected until a key frame
+        encoder.encode_frame(render_frame(imgui, 56, 60.0))
+        assert not decoder.decode_frame(encoder.encode_frame(render_frame(imgui, 56, 60.0)))
+        encoder.request_key_frame()
+        assert decoder.decode_frame(encoder.encode_frame(render_frame(imgui, 56, 60.0)))
+        assert_same_draw_data(decoder, imgui.get_draw_data())
+    finally:
+        imgui.destroy_context(ctx)
+
+
+def test_remoting_loopback():
+    if sys.platform == "win32":
+        return
+
+    from imgui_bundle import imgui, immapp
+
+    ctx = imgui.create_context()
+    try:
+        init_headless_context(imgui)
+
+        link_params = immapp.RemotingLinkParams()
+        link_params.bandwidth = 100e3
+        link_params.latency = 0.05
+        loopback = immapp.RemotingLoopback(link_params)
+        nb_frames = 120
+        for frame in range(nb_frames):
+            loopback.on_frame_rendered(render_frame(imgui, frame, 20.0 + frame), now=frame / 60.0)
+
+        stats = loopback.stats()
+        assert stats.nb_frames_rendered == nb_frames
+        assert 0 < stats.nb_frames_decoded <= stats.nb_frames_sent <= nb_frames
+        assert stats.bytes_sent < stats.raw_bytes
+        assert stats.average_latency >= link_params.latency
+    finally:
+        imgui.destroy_context(ctx)
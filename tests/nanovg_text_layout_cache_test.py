@@ -0,0 +1,87 @@
+# Part of ImGui Bundle - MIT License - Copyright (c) 2022-2023 Pascal Thomet - https://github.com/pthom/imgui_bundle
+
+# Checks the hits / misses of NvgTextLayoutCache, and that its row offsets match nvgTextBreakLines.
+# NanoVG needs an OpenGL context: the checks run inside a HelloImGui app, for one frame.
+import os
+import sys
+
+
+TEXT = "The quick brown fox jumps over the lazy dog, again and again"
+BREAK_ROW_WIDTH = 120.0
+
+
+def rows_text(layout):
+    text_bytes = layout.text.encode("utf-8")
+    return [text_bytes[row.start:row.end].decode("utf-8") for row in layout.rows]
+
+
+def check_layout_cache(results):
+    from imgui_bundle import hello_imgui, nanovg as nvg
+
+    vg = nvg.nvg_imgui.create_nvg_context_hello_imgui()
+    try:
+        font_id = nvg.create_font(vg, "roboto", hello_imgui.asset_file_full_path("fonts/Roboto/Roboto-Regular.ttf"))
+        style = nvg.NvgTextStyleKey(font_id=font_id, font_size=18.0)
+        cache = nvg.NvgTextLayoutCache()
+
+        # A different style is set on the context: Layout() must apply its own style before computing
+        nvg.font_size(vg, 40.0)
+        cache.new_frame()
+        layout = cache.layout(vg, style, TEXT, BREAK_ROW_WIDTH)
+        layout_again = cache.layout(vg, style, TEXT, BREAK_ROW_WIDTH)
+        results["first_frame_counts"] = (cache.frame_miss_count(), cache.frame_reuse_count())
+
+        # The style stays set on the context, so that nvgTextBreakLines gives the reference rows
+        expected_rows = [row.row_text for row in nvg.text_break_lines(vg, TEXT, BREAK_ROW_WIDTH)]
+        results["rows"] = (rows_text(layout), rows_text(layout_again), expected_rows)
+
+        # A change of font size or of transform scale is a miss
+        cache.new_frame()
+        cache.layout(vg, nvg.NvgTextStyleKey(font_id=font_id, font_size=24.0), TEXT, BREAK_ROW_WIDTH)
+        nvg.save(vg)
+        nvg.scale(vg, 2.0, 2.0)
+        cache.layout(vg, style, TEXT, BREAK_ROW_WIDTH)
+        nvg.restore(vg)
+        cache.layout(vg, style, TEXT, BREAK_ROW_WIDTH)
+        results["second_frame_counts"] = (cache.frame_miss_count(), cache.frame_reuse_count())
+        results["size"] = cache.size()
+
+        # Unused entries are evicted, but the returned layouts stay valid
+        cache.max_unused_frames = 1
+        for _ in range(3):
+            cache.new_frame()
+        results["size_after_eviction"] = cache.size()
+        results["evicted_layout_rows"] = rows_text(layout)
+    finally:
+        nvg.nvg_imgui.delete_nvg_context_hello_imgui(vg)
+
+
+def test_nvg_text_layout_cache():
+    if sys.platform.startswith("linux") and not os.environ.get("DISPLAY") and not os.environ.get("WAYLAND_DISPLAY"):
+        return
+
+    from imgui_bundle import hello_imgui
+
+    results = {}
+    runner_params = hello_imgui.RunnerParams()
+    runner_params.app_window_params.hidden = True
+    runner_params.fps_idling.enable_idling = False
+
+    def gui():
+        if not results:
+            check_layout_cache(results)
+        hello_imgui.get_runner_params().app_shall_exit = True
+
+    runner_params.callbacks.show_gui = gui
+    hello_imgui.run(runner_params)
+
+    assert results["first_frame_counts"] == (1, 1)
+    layout_rows, layout_again_rows, expected_rows = results["rows"]
+    assert len(expected_rows) > 1
+    assert layout_rows == expected_rows
+    assert layout_again_rows == expected_rows
+
+    assert results["second_frame_counts"] == (2, 1)
+    assert results["size"] == 3
+    assert results["size_after_eviction"] == 0
+    assert results["evicted_layout_rows"] == expected_rows
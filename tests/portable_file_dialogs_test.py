@@ -0,0 +1,71 @@
+# Part of ImGui Bundle - MIT License - Copyright (c) 2022-2023 Pascal Thomet - https://github.com/pthom/imgui_bundle
+
+# Checks that polling a pending file dialog from the UI loop does not add per-frame latency.
+# The dialog is provided by a stub "zenity" script, so that this test runs on headless Linux CI runners.
+import os
+import stat
+import sys
+import time
+
+
+STUB_ZENITY = """#!/bin/sh
+sleep 0.3
+echo /tmp/chosen_file.txt
+exit 0
+"""
+
+
+def install_stub_zenity(tmp_path, monkeypatch):
+    zenity = tmp_path / "zenity"
+    zenity.write_text(STUB_ZENITY)
+    zenity.chmod(zenity.stat().st_mode | stat.S_IEXEC)
+    # The stub must be found first (the desktop helpers are scanned once per process, on first use)
+    monkeypatch.setenv("PATH", str(tmp_path) + os.pathsep + os.environ.get("PATH", ""))
+    monkeypatch.setenv("XDG_SESSION_DESKTOP", "gnome")
+
+
+def test_pending_dialog_polling_does_not_block(tmp_path, monkeypatch):
+    if not sys.platform.startswith("linux"):
+        return
+
+    install_stub_zenity(tmp_path, monkeypatch)
+
+    from imgui_bundle import portable_file_dialogs as pfd
+
+    callback_calls = []
+    dialog = pfd.open_file("Open")
+    dialog.on_ready(lambda: callback_calls.append(True))
+
+    max_poll_duration = 0.0
+    nb_pending_polls = 0
+    deadline = time.monotonic() + 10.0
+    while True:
+        t0 = time.monotonic()
+        is_ready = dialog.ready()
+        max_poll_duration = max(max_poll_duration, time.monotonic() - t0)
+        if is_ready:
+            break
+        nb_pending_polls += 1
+        assert time.monotonic() < deadline
+        time.sleep(0.016)  # one frame
+
+    assert nb_pending_polls > 0
+    # The former implementation slept 20 ms in ready() while the dialog was pending
+    assert max_poll_duration < 0.005
+    assert callback_calls == [True]
+    assert dialog.result() == ["/tmp/chosen_file.txt"]
+
+
+def test_on_ready_not_called_after_destruction(tmp_path, monkeypatch):
+    if not sys.platform.startswith("linux"):
+        return
+
+    install_stub_zenity(tmp_path, monkeypatch)
+
+    from imgui_bundle import portable_file_dialogs as pfd
+
+    callback_calls = []
+    dialog = pfd.open_file("Open")
+    dialog.on_ready(lambda: callback_calls.append(True))
+    del dialog  # waits for the dialog to complete
+    assert callback_calls == []